@@ -101,6 +101,21 @@ if __name__ == "__main__":
         help="Set the namespace containing the utils classes if they should be referenced instead of generated.",
     )
 
+    parser.add_argument(
+        "--unity",
+        dest="unity_batch_size",
+        default=0,
+        type=int,
+        help="Compile-time reduction mode, bundle every N generated .cpp files of a package into a unity/jumbo source and emit precompiled headers (templates with the 'unity' filter). 0 disables.",
+    )
+
+    parser.add_argument(
+        "--cache-serialized",
+        dest="cache_serialized",
+        action="store_true",
+        help="Generated structs track modifications and cache their serialized bytes, re-serializing an unchanged object is a copy of the cache.",
+    )
+
     parser.add_argument(
         "-nsm",
         "--namespace_map",
@@ -157,6 +172,8 @@ if __name__ == "__main__":
         settings = Settings()
 
     settings.utils_ns = args.utils_ns
+    settings.unity_batch_size = args.unity_batch_size or settings.unity_batch_size
+    settings.cache_serialized = args.cache_serialized or settings.cache_serialized
 
     for override in args.ns_overrides:
         type_name, ns = override.split(",")
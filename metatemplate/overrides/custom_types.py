@@ -23,5 +23,5 @@ CUSTOM_QNAME_INCLUDES = {
 CUSTOM_UTIL_INCLUDES = {
     "{custom_schema}utils::UUID": "utils/UUID.h",
     "{custom_schema}utils::Duration": "utils/Duration.h",
-    "{custom_schema}utils::TimePoint": "utils/Datetime.h",
+    "{custom_schema}utils::TimePoint": "utils/TimePoint.h",
 }
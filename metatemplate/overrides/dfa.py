@@ -0,0 +1,405 @@
+import unicodedata
+from typing import Dict, FrozenSet, List, Optional, Tuple
+
+
+class UnsupportedPattern(ValueError):
+    """Raised for pattern syntax the DFA compiler does not handle (e.g. \\p{..} categories)"""
+
+
+class CharSet:
+    """A set of characters split into the ASCII bytes matched and whether any non ASCII
+    code point (a whole UTF-8 sequence) is matched. Non ASCII code points are matched as
+    a group since the generated matcher runs on bytes, that is exact for ".", negated
+    classes and literals, an approximation for \\w, \\d, \\i and \\c.
+    """
+
+    ALL_ASCII = frozenset(range(128))
+
+    def __init__(self, ascii: FrozenSet[int] = frozenset(), non_ascii: bool = False):
+        self.ascii = frozenset(ascii)
+        self.non_ascii = non_ascii
+
+    def union(self, other: "CharSet") -> "CharSet":
+        return CharSet(self.ascii | other.ascii, self.non_ascii or other.non_ascii)
+
+    def subtract(self, other: "CharSet") -> "CharSet":
+        return CharSet(self.ascii - other.ascii, self.non_ascii and not other.non_ascii)
+
+    def negate(self) -> "CharSet":
+        return CharSet(CharSet.ALL_ASCII - self.ascii, not self.non_ascii)
+
+
+def _ascii_where(predicate) -> FrozenSet[int]:
+    return frozenset(c for c in range(128) if predicate(chr(c)))
+
+
+# XSD multi character escapes, restricted to ASCII plus the non ASCII flag
+_MULTI_ESCAPES = {
+    "s": CharSet(frozenset(b" \t\n\r")),
+    "d": CharSet(_ascii_where(str.isdigit)),
+    # \w is everything but punctuation, separators and other (so "_" is not a word char)
+    "w": CharSet(
+        _ascii_where(lambda c: unicodedata.category(c)[0] not in "PZC"), non_ascii=True
+    ),
+    "i": CharSet(_ascii_where(lambda c: c.isalpha() or c in "_:"), non_ascii=True),
+    "c": CharSet(
+        _ascii_where(lambda c: c.isalnum() or c in "-._:"), non_ascii=True
+    ),
+}
+_SINGLE_ESCAPES = {"n": "\n", "r": "\r", "t": "\t"}
+# "." is any character but the line ends
+_ANY = CharSet(CharSet.ALL_ASCII - frozenset(b"\n\r"), non_ascii=True)
+
+# NFA/DFA size guards, patterns beyond them fall back to no check
+_MAX_NFA_STATES = 20000
+_MAX_DFA_STATES = 4096
+
+
+class _Parser:
+    """Recursive descent parser for the XSD regular expression grammar producing a small AST:
+    ("set", CharSet), ("seq", [nodes]), ("alt", [nodes]), ("repeat", node, min, max|None)
+    """
+
+    def __init__(self, pattern: str):
+        self.text = pattern
+        self.pos = 0
+
+    def parse(self):
+        node = self.regex()
+        if self.pos != len(self.text):
+            raise UnsupportedPattern(f"unexpected '{self.text[self.pos]}' at {self.pos}")
+        return node
+
+    def peek(self) -> Optional[str]:
+        return self.text[self.pos] if self.pos < len(self.text) else None
+
+    def take(self) -> str:
+        if self.pos >= len(self.text):
+            raise UnsupportedPattern("unexpected end of pattern")
+        char = self.text[self.pos]
+        self.pos += 1
+        return char
+
+    def expect(self, char: str) -> None:
+        if self.take() != char:
+            raise UnsupportedPattern(f"expected '{char}' at {self.pos - 1}")
+
+    def regex(self):
+        branches = [self.branch()]
+        while self.peek() == "|":
+            self.take()
+            branches.append(self.branch())
+        return branches[0] if len(branches) == 1 else ("alt", branches)
+
+    def branch(self):
+        pieces = []
+        while self.peek() is not None and self.peek() not in "|)":
+            pieces.append(self.piece())
+        return ("seq", pieces)
+
+    def piece(self):
+        atom = self.atom()
+        char = self.peek()
+        if char == "?":
+            self.take()
+            return ("repeat", atom, 0, 1)
+        if char == "*":
+            self.take()
+            return ("repeat", atom, 0, None)
+        if char == "+":
+            self.take()
+            return ("repeat", atom, 1, None)
+        if char == "{":
+            self.take()
+            low = self.number()
+            high = low
+            if self.peek() == ",":
+                self.take()
+                high = self.number() if self.peek() != "}" else None
+            self.expect("}")
+            if high is not None and high < low:
+                raise UnsupportedPattern("quantifier maximum below minimum")
+            return ("repeat", atom, low, high)
+        return atom
+
+    def number(self) -> int:
+        start = self.pos
+        while self.peek() is not None and self.peek().isdigit():
+            self.take()
+        if start == self.pos:
+            raise UnsupportedPattern(f"expected a number at {start}")
+        return int(self.text[start : self.pos])
+
+    def atom(self):
+        char = self.take()
+        if char == "(":
+            if self.text.startswith("?:", self.pos):
+                self.pos += 2
+            node = self.regex()
+            self.expect(")")
+            return node
+        if char == "[":
+            return ("set", self.char_class())
+        if char == ".":
+            return ("set", _ANY)
+        if char == "\\":
+            escaped = self.escape()
+            return ("set", escaped) if isinstance(escaped, CharSet) else _literal(escaped)
+        if char in "?*+{":
+            raise UnsupportedPattern(f"nothing to repeat at {self.pos - 1}")
+        return _literal(char)
+
+    def escape(self):
+        """returns a CharSet for multi character escapes, otherwise the escaped character"""
+        char = self.take()
+        if char in _SINGLE_ESCAPES:
+            return _SINGLE_ESCAPES[char]
+        if char.lower() in _MULTI_ESCAPES:
+            charset = _MULTI_ESCAPES[char.lower()]
+            return charset.negate() if char.isupper() else charset
+        if char in "pP":
+            raise UnsupportedPattern("unicode category escapes are not supported")
+        if char.isalnum():
+            raise UnsupportedPattern(f"unknown escape \\{char}")
+        return char
+
+    def class_char(self):
+        char = self.take()
+        return self.escape() if char == "\\" else char
+
+    def char_class(self) -> CharSet:
+        negated = self.peek() == "^"
+        if negated:
+            self.take()
+        charset = CharSet()
+        first = True
+        while True:
+            char = self.peek()
+            if char is None:
+                raise UnsupportedPattern("unterminated character class")
+            if char == "]" and not first:
+                self.take()
+                break
+            if char == "-" and self.text.startswith("-[", self.pos):
+                # XSD class subtraction [a-z-[aeiou]], applied after the negation
+                self.pos += 2
+                base = charset.negate() if negated else charset
+                subtracted = base.subtract(self.char_class())
+                self.expect("]")
+                return subtracted
+            first = False
+            item = self.class_char()
+            if isinstance(item, CharSet):
+                charset = charset.union(item)
+                continue
+            if self.peek() == "-" and self.text[self.pos + 1 : self.pos + 2] not in ("]", "["):
+                self.take()
+                high = self.class_char()
+                if isinstance(high, CharSet) or ord(high) < ord(item):
+                    raise UnsupportedPattern("invalid character range")
+                charset = charset.union(_char_range(item, high))
+            else:
+                charset = charset.union(_char_range(item, item))
+        return charset.negate() if negated else charset
+
+
+def _char_range(low: str, high: str) -> CharSet:
+    if ord(high) > 127:
+        raise UnsupportedPattern("non ASCII characters in a class are not supported")
+    return CharSet(frozenset(range(ord(low), ord(high) + 1)))
+
+
+def _literal(char: str):
+    """A literal character, non ASCII ones are the sequence of their UTF-8 bytes"""
+    encoded = char.encode("utf-8")
+    if len(encoded) == 1:
+        return ("set", CharSet(frozenset(encoded)))
+    return ("bytes", encoded)
+
+
+class _Nfa:
+    """Thompson construction over bytes"""
+
+    CONTINUATION = frozenset(range(0x80, 0xC0))
+    # lead bytes of 2, 3 and 4 byte UTF-8 sequences
+    LEADS = (
+        (frozenset(range(0xC2, 0xE0)), 1),
+        (frozenset(range(0xE0, 0xF0)), 2),
+        (frozenset(range(0xF0, 0xF5)), 3),
+    )
+
+    def __init__(self):
+        self.edges: List[List[Tuple[FrozenSet[int], int]]] = []
+        self.epsilons: List[List[int]] = []
+
+    def state(self) -> int:
+        if len(self.edges) >= _MAX_NFA_STATES:
+            raise UnsupportedPattern("pattern is too large")
+        self.edges.append([])
+        self.epsilons.append([])
+        return len(self.edges) - 1
+
+    def build(self, node) -> Tuple[int, int]:
+        kind = node[0]
+        start = self.state()
+        end = self.state()
+        if kind == "set":
+            charset = node[1]
+            if charset.ascii:
+                self.edges[start].append((charset.ascii, end))
+            if charset.non_ascii:
+                for lead, continuations in _Nfa.LEADS:
+                    current = self.state()
+                    self.edges[start].append((lead, current))
+                    for _ in range(continuations - 1):
+                        following = self.state()
+                        self.edges[current].append((_Nfa.CONTINUATION, following))
+                        current = following
+                    self.edges[current].append((_Nfa.CONTINUATION, end))
+        elif kind == "bytes":
+            current = start
+            for byte in node[1]:
+                following = self.state()
+                self.edges[current].append((frozenset([byte]), following))
+                current = following
+            self.epsilons[current].append(end)
+        elif kind == "seq":
+            current = start
+            for child in node[1]:
+                child_start, child_end = self.build(child)
+                self.epsilons[current].append(child_start)
+                current = child_end
+            self.epsilons[current].append(end)
+        elif kind == "alt":
+            for child in node[1]:
+                child_start, child_end = self.build(child)
+                self.epsilons[start].append(child_start)
+                self.epsilons[child_end].append(end)
+        elif kind == "repeat":
+            _, child, low, high = node
+            current = start
+            for _ in range(low):
+                child_start, child_end = self.build(child)
+                self.epsilons[current].append(child_start)
+                current = child_end
+            if high is None:
+                child_start, child_end = self.build(child)
+                self.epsilons[current].append(child_start)
+                self.epsilons[child_end].append(child_start)
+                self.epsilons[child_end].append(end)
+                self.epsilons[current].append(end)
+            else:
+                for _ in range(high - low):
+                    child_start, child_end = self.build(child)
+                    self.epsilons[current].append(child_start)
+                    self.epsilons[current].append(end)
+                    current = child_end
+                self.epsilons[current].append(end)
+        return start, end
+
+    def closure(self, states) -> FrozenSet[int]:
+        stack = list(states)
+        seen = set(stack)
+        while stack:
+            for following in self.epsilons[stack.pop()]:
+                if following not in seen:
+                    seen.add(following)
+                    stack.append(following)
+        return frozenset(seen)
+
+
+def compile_pattern(pattern: str) -> Dict[str, object]:
+    """Compiles an XSD pattern restriction into a minimal DFA over the UTF-8 bytes of the
+    value. XSD patterns match the whole value, a leading "^" and trailing "$" are dropped
+    since schemas commonly carry them over from other regex dialects.
+
+    returns the byte "classes" (byte -> column), flat "transitions" (state * class_count +
+    class), "accepting" flags, "class_count", "state_count" and the smallest "state_type".
+    State 0 is the dead state and 1 the start.
+
+    raises UnsupportedPattern for syntax outside of what is handled
+    """
+    if pattern.startswith("^"):
+        pattern = pattern[1:]
+    if pattern.endswith("$") and not pattern.endswith("\\$"):
+        pattern = pattern[:-1]
+
+    nfa = _Nfa()
+    nfa_start, nfa_end = nfa.build(_Parser(pattern).parse())
+
+    # bytes that no edge tells apart share a column of the transition table
+    labels = {label for edges in nfa.edges for label, _ in edges}
+    signatures: Dict[Tuple[bool, ...], int] = {}
+    classes = []
+    ordered_labels = sorted(labels, key=sorted)
+    for byte in range(256):
+        signature = tuple(byte in label for label in ordered_labels)
+        classes.append(signatures.setdefault(signature, len(signatures)))
+    class_count = len(signatures)
+    representatives = [classes.index(column) for column in range(class_count)]
+
+    # subset construction, state 0 is the empty (dead) set
+    dead = frozenset()
+    subsets = [dead, nfa.closure([nfa_start])]
+    index_of = {subset: index for index, subset in enumerate(subsets)}
+    transitions = [[0] * class_count for _ in subsets]
+    pending = [1]
+    while pending:
+        current = pending.pop()
+        for column, byte in enumerate(representatives):
+            moved = [
+                following
+                for state in subsets[current]
+                for label, following in nfa.edges[state]
+                if byte in label
+            ]
+            target = nfa.closure(moved) if moved else dead
+            if target not in index_of:
+                if len(subsets) >= _MAX_DFA_STATES:
+                    raise UnsupportedPattern("pattern needs too many states")
+                index_of[target] = len(subsets)
+                subsets.append(target)
+                transitions.append([0] * class_count)
+                pending.append(index_of[target])
+            transitions[current][column] = index_of[target]
+    accepting = [nfa_end in subset for subset in subsets]
+
+    # Moore minimization, states that can no longer accept merge into the dead block
+    blocks = [1 if accepting[index] else 0 for index in range(len(subsets))]
+    while True:
+        keys = {}
+        refined = []
+        for index in range(len(subsets)):
+            key = (blocks[index], tuple(blocks[target] for target in transitions[index]))
+            refined.append(keys.setdefault(key, len(keys)))
+        if len(keys) == len(set(blocks)):
+            break
+        blocks = refined
+
+    # renumber so the dead block is 0 and the start block 1
+    order = {blocks[0]: 0}
+    if blocks[1] not in order:
+        order[blocks[1]] = 1
+    for block in blocks:
+        order.setdefault(block, len(order))
+    state_count = len(order)
+    minimal = [[0] * class_count for _ in range(state_count)]
+    minimal_accepting = [False] * state_count
+    for index in range(len(subsets)):
+        state = order[blocks[index]]
+        minimal[state] = [order[blocks[target]] for target in transitions[index]]
+        minimal_accepting[state] = accepting[index]
+    if state_count == 1:
+        # nothing can match, keep a start state that is dead too
+        minimal.append([0] * class_count)
+        minimal_accepting.append(False)
+        state_count = 2
+
+    return {
+        "classes": classes,
+        "transitions": [target for row in minimal for target in row],
+        "accepting": minimal_accepting,
+        "class_count": class_count,
+        "state_count": state_count,
+        "state_type": "std::uint8_t" if state_count <= 256 else "std::uint16_t",
+    }
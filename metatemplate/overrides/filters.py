@@ -9,6 +9,7 @@ from typing import (
 )
 from collections.abc import Callable
 import hashlib
+import logging
 import re
 
 from jinja2 import Environment
@@ -23,6 +24,7 @@ from .custom_types import (
     CUSTOM_UTIL_INCLUDES,
     PLACEHOLDER_PREFIX,
 )
+from .dfa import UnsupportedPattern, compile_pattern
 from .mapper import AbstractMapper
 
 
@@ -67,6 +69,29 @@ class AgFilters:
         "boolean": "bool",
     }
 
+    NUMERIC_CPP_TYPES = frozenset(
+        [
+            "double",
+            "int8_t",
+            "int16_t",
+            "int32_t",
+            "int64_t",
+            "uint8_t",
+            "uint16_t",
+            "uint32_t",
+            "uint64_t",
+        ]
+    )
+
+    # relative cost of comparing a member, see __equality_cost
+    EQUALITY_COST_SCALAR = 0
+    EQUALITY_COST_TOLERANT = 1
+    EQUALITY_COST_STRING = 2
+    EQUALITY_COST_PARENT = 3
+    EQUALITY_COST_PRIMITIVE_LIST = 4
+    EQUALITY_COST_NESTED = 5
+    EQUALITY_COST_LIST = 6
+
     PYNATIVE2INCL_MAP = {
         "List": "<vector>",
         "Optional": "<optional>",
@@ -148,6 +173,8 @@ class AgFilters:
                 "class.all_ctor_init": self.cls_all_ctor_init,
                 "class.inherited_attrs": self.cls_inherited_attrs,
                 "class.equality_checks": self.cls_equality_checks,
+                "class.equality_ordered_attrs": self.cls_equality_ordered_attrs,
+                "member.equality_check": self.member_equality_check,
                 "class.abstract_parent": self.cls_abstract_parent_type,
                 "class.abstract_base": self.cls_abstract_base_type,
                 "member.type_name": self.type_name,
@@ -173,10 +200,12 @@ class AgFilters:
                 "enum.name": self.enum_name,
                 "enum.value": self.enum_value,
                 "enum.class_base": self.enum_class_base,
+                "enum.perfect_hash": self.enum_perfect_hash,
                 "alias.includes": self.alias_includes,
                 "alias.restriction": self.alias_restriction,
                 "alias.default": self.alias_default,
                 "alias.primitive": self.alias_primitive,
+                "alias.pattern_dfa": self.alias_pattern_dfa,
                 "variant.includes": self.variant_includes,
                 "variant.cpp_includes": self.variant_cpp_includes,
                 "variant.choices": self.variant_choices,
@@ -199,6 +228,8 @@ class AgFilters:
                 "member.is_custom": self.is_custom_attr,
                 "member.is_list": self.is_list_attr,
                 "member.is_primitive_list": self.is_primitive_list_attr,
+                "member.is_numeric_list": self.is_numeric_list_attr,
+                "member.is_numeric": self.is_numeric_attr,
                 "member.is_optional_type": self.is_optional_attr,
                 "member.is_enum": self.is_enum_attr,
                 "member.is_floating_point": self.is_fp_attr,
@@ -208,9 +239,12 @@ class AgFilters:
                 "class.is_abstract": self.is_abstract_class,
                 "class.extends_abstract": self.extends_abstract_class,
                 "class.is_complex_type": self.is_complex_type,
+                "class.shares_members": self.cls_shares_members,
                 "ext.is_abstract": self.is_abstract_ext,
                 "alias.is_string": self.alias_is_string,
                 "alias.is_float": self.alias_is_float,
+                "alias.is_bulk_copyable": self.alias_is_bulk_copyable,
+                "alias.is_literal": self.alias_is_literal,
                 "alias.has_restriction": self.alias_has_restriction,
                 "alias.has_default": self.alias_has_default,
                 "proto.native_type": self.is_proto_native,
@@ -365,6 +399,22 @@ class AgFilters:
         """
         return self.alias_restriction(clazz, key) is not None
 
+    def alias_pattern_dfa(self, clazz: Class) -> Optional[Dict[str, Any]]:
+        """Compile the pattern restriction of a string alias into DFA tables (see dfa.py) so
+        the generated check is a table walk instead of a runtime regex. Patterns using syntax
+        the compiler does not support are left unchecked with a warning.
+        """
+        pattern = self.alias_restriction(clazz, "pattern")
+        if pattern is None or not self.alias_is_string(clazz):
+            return None
+        try:
+            return compile_pattern(pattern)
+        except UnsupportedPattern as error:
+            logging.getLogger(__name__).warning(
+                "%s: pattern %r is not checked, %s", clazz.name, pattern, error
+            )
+            return None
+
     def alias_primitive(self, clazz: Class) -> str:
         """return the name of the class that an alias extends/wraps."""
         ext_attr = next(iter(clazz.attrs), {})
@@ -393,6 +443,32 @@ class AgFilters:
         """return true if clazz is an alias that wraps a floating point type"""
         return self.alias_is_type(clazz, "float") or self.alias_is_type(clazz, "double")
 
+    def alias_is_bulk_copyable(self, clazz: Class) -> bool:
+        """return true if clazz is an alias that wraps a fixed size type whose bytes are its
+        byte stream encoding (numbers and time types), lists of it are copied in bulk.
+        """
+        return self.alias_primitive(clazz) in AgFilters.NUMERIC_CPP_TYPES | {
+            "utils::Duration",
+            "utils::TimePoint",
+        }
+
+    def alias_is_literal(self, clazz: Class) -> bool:
+        """return true if clazz is an alias whose alias_type is a C++ literal type (numbers,
+        bool, time types and enums), only those get constexpr bounds/constructors/checks.
+        """
+        if self.alias_primitive(clazz) in AgFilters.NUMERIC_CPP_TYPES | {
+            "bool",
+            "utils::Duration",
+            "utils::TimePoint",
+        }:
+            return True
+        ext_attr = next(iter(clazz.attrs), {})
+        ext_type = next(iter(getattr(ext_attr, "types", [])), None)
+        if ext_type is None or getattr(ext_type, "native", False):
+            return False
+        ext_class = self.resolver.class_map.get(ext_type.qname)
+        return ext_class is not None and ext_class.is_enumeration
+
     def enum_name(self, attr: Attr) -> str:
         """return the keyword name of an enum."""
         return f"{attr.name}"
@@ -409,6 +485,65 @@ class AgFilters:
         # TODO(nd): add support for custom values/types
         return None
 
+    def __enum_name_hash(self, name: str, seed: int) -> int:
+        """Mirror of utils::enumNameHash in the generated Enum.h, keep both in sync."""
+        mask = 0xFFFFFFFF
+        value = 2166136261 ^ ((seed * 0x9E3779B9) & mask)
+        for byte in name.encode("utf-8"):
+            value = ((value ^ byte) * 16777619) & mask
+        value ^= value >> 16
+        value = (value * 0x85EBCA6B) & mask
+        value ^= value >> 13
+        return value
+
+    def enum_perfect_hash(self, clazz: Class) -> Dict[str, List[int]]:
+        """Builds a minimal collision free (hash and displace) table over the enum names so
+        fromString is two hashes and a single compare. Names hash to a bucket, each bucket
+        gets the first displacement (seed) that lands all of its names in free slots.
+
+        returns displacements per bucket and slots holding the name index, or the name count
+        for an empty slot. Both sizes are powers of two.
+        """
+        names = [self.enum_name(attr) for attr in clazz.attrs]
+        count = len(names)
+        slot_count = 1
+        while slot_count < count:
+            slot_count <<= 1
+        bucket_count = 1
+        while bucket_count * 2 < count:
+            bucket_count <<= 1
+
+        while True:
+            buckets: List[List[int]] = [[] for _ in range(bucket_count)]
+            for index, name in enumerate(names):
+                buckets[self.__enum_name_hash(name, 0) & (bucket_count - 1)].append(index)
+
+            slots = [count] * slot_count
+            displacements = [0] * bucket_count
+            placed = True
+            for bucket in sorted(range(bucket_count), key=lambda b: -len(buckets[b])):
+                if not buckets[bucket]:
+                    break
+                for seed in range(1, 1 << 16):
+                    taken = [
+                        self.__enum_name_hash(names[index], seed) & (slot_count - 1)
+                        for index in buckets[bucket]
+                    ]
+                    if len(set(taken)) == len(taken) and all(
+                        slots[slot] == count for slot in taken
+                    ):
+                        break
+                else:
+                    placed = False
+                    break
+                displacements[bucket] = seed
+                for index, slot in zip(buckets[bucket], taken):
+                    slots[slot] = index
+            if placed:
+                return {"displacements": displacements, "slots": slots}
+            # too full to place every bucket, retry with more room
+            slot_count <<= 1
+
     def __cpp_native_include(self, type) -> str:
         return None
 
@@ -562,28 +697,77 @@ class AgFilters:
             + [self.__ctor_arg_w_opt(include_defaults)(attr) for attr in opt_attrs]
         )
 
+    def __equality_cost(self, attr: Attr) -> int:
+        """Rough cost of comparing a member: fixed size values first, then strings, then
+        contiguous primitive lists (memcmp or the SIMD EssentiallyEqual), nested types and
+        lists of strings/structs last. Polymorphic members compare by pointer.
+        """
+        if attr.is_list:
+            if self.is_numeric_list_attr(attr) or self.is_enum_attr(attr):
+                return AgFilters.EQUALITY_COST_PRIMITIVE_LIST
+            # std::vector<bool> is packed, not a numeric list but as cheap to compare
+            if self.is_native_attr(attr) and self.raw_type_name(attr) == "bool":
+                return AgFilters.EQUALITY_COST_PRIMITIVE_LIST
+            return AgFilters.EQUALITY_COST_LIST
+        if self.is_abstract_attr(attr) or self.is_enum_attr(attr):
+            return AgFilters.EQUALITY_COST_SCALAR
+        if self.is_custom_attr(attr):
+            return AgFilters.EQUALITY_COST_TOLERANT
+        if self.is_native_attr(attr):
+            if self.raw_type_name(attr) == "std::string":
+                return AgFilters.EQUALITY_COST_STRING
+            if self.is_fp_attr(attr):
+                return AgFilters.EQUALITY_COST_TOLERANT
+            return AgFilters.EQUALITY_COST_SCALAR
+        if self.is_simple_attr(attr):
+            return (
+                AgFilters.EQUALITY_COST_STRING
+                if self.alias_is_string(self.member_class(attr))
+                else AgFilters.EQUALITY_COST_TOLERANT
+            )
+        return AgFilters.EQUALITY_COST_NESTED
+
+    def cls_equality_ordered_attrs(self, clazz: Class) -> List[Attr]:
+        """The members of a class in the order operator== compares them, cheapest first so a
+        mismatch short circuits before the expensive comparisons. The sort is stable, equal
+        cost members keep the schema order.
+        """
+        return sorted(clazz.attrs, key=self.__equality_cost)
+
     def cls_equality_checks(self, clazz: Class, lhs: str, rhs: str) -> List[str]:
         """A list of equality boolean expressions to prove an object of the same type
-        is equal, in cpp scope should be joined by &&.
+        is equal, in cpp scope should be joined by &&. Ordered by cost, the parents after
+        the fixed size members and strings, the polymorphic equals() always last.
         """
         checks = []
-        for ex in clazz.extensions:
-            checks.append(
-                f"dynamic_cast<const {self.ext_type(ex)}&>({lhs}) == dynamic_cast<const {self.ext_type(ex)}&>({rhs})"
-            )
-
-        for attr in clazz.attrs:
-            getter = self.getter(attr)
-            if self.is_fp_attr(attr):
-                checks.append(
-                    f"utils::EssentiallyEqual({lhs}.{getter}(), {rhs}.{getter}())"
-                )
-            else:
-                checks.append(f"{lhs}.{getter}() == {rhs}.{getter}()")
+        parents_added = False
+        for attr in self.cls_equality_ordered_attrs(clazz):
+            if not parents_added and self.__equality_cost(attr) > AgFilters.EQUALITY_COST_PARENT:
+                checks.extend(self.__parent_equality_checks(clazz, lhs, rhs))
+                parents_added = True
+            checks.append(self.member_equality_check(attr, lhs, rhs))
+        if not parents_added:
+            checks.extend(self.__parent_equality_checks(clazz, lhs, rhs))
         if self.is_abstract_class(clazz):
             checks.append(f"{lhs}.equals({rhs})")
         return checks
 
+    def __parent_equality_checks(self, clazz: Class, lhs: str, rhs: str) -> List[str]:
+        return [
+            f"dynamic_cast<const {self.ext_type(ex)}&>({lhs}) == dynamic_cast<const {self.ext_type(ex)}&>({rhs})"
+            for ex in clazz.extensions
+        ]
+
+    def member_equality_check(self, attr: Attr, lhs: str, rhs: str) -> str:
+        """The equality boolean expression for a single member of two objects of the same
+        type, floating point members are compared with a ULP tolerance (lists of them in bulk,
+        see EssentiallyEqual.h).
+        """
+        getter = self.getter(attr)
+        if self.is_fp_attr(attr):
+            return f"utils::EssentiallyEqual({lhs}.{getter}(), {rhs}.{getter}())"
+        return f"{lhs}.{getter}() == {rhs}.{getter}()"
+
     def cls_abstract_parent_type(self, clazz: Class) -> Class:
         """If a class is the extension of an abstract base type, this
         method returns the class object representing that abstract base class.
@@ -668,15 +852,28 @@ class AgFilters:
         """
         if self.is_native_attr(attr):
             return False
-        if not self.is_abstract_attr(attr):
+        if self.is_custom_attr(attr):
+            return False
+        if not self.is_abstract_attr(attr) and not self.is_compound_attr(attr):
             if attr.is_optional:
                 return False
             elif attr.is_list:
                 return False
-        if self.is_custom_attr(attr):
-            return False
         return True
 
+    def is_compound_attr(self, attr: Attr) -> bool:
+        """true if the member is a generated struct or variant. The header only names
+        them in std::vector/std::optional declarations (the pimpl holds the values),
+        so they are forward declared even as list/optional members, unlike aliases
+        and enums which are cheap to include.
+        """
+        if self.is_native_attr(attr) or self.is_custom_attr(attr):
+            return False
+        try:
+            return not self.member_class(attr).is_simple_type
+        except KeyError:
+            return False
+
     def is_enum_attr(self, attr: Attr) -> bool:
         """return true if the member is an instance of an enumeration type"""
         try:
@@ -882,8 +1079,15 @@ class AgFilters:
         """return the cpp const ref type of a member, in the case
         of a native type (string, double, float, etc) it is not a ref
         since those would pass by value instead of ref.
+
+        NOTE: lists of native types are still returned by const ref, copying
+        the vector for every read is expensive and prevents views over the storage.
         """
-        if self.is_native_attr(attr) and not self.is_optional_attr(attr):
+        if (
+            self.is_native_attr(attr)
+            and not self.is_optional_attr(attr)
+            and not attr.is_list
+        ):
             return self.type_name(attr)
         else:
             return f"const {self.type_name(attr)}&"
@@ -912,6 +1116,29 @@ class AgFilters:
         else:
             return False
 
+    def cls_shares_members(self, clazz: Class, seen: Optional[set] = None) -> bool:
+        """return true if a copy of the class can share state with the original,
+        i.e. it holds an abstract member (std::shared_ptr) directly, through a parent,
+        a variant choice or a nested type.
+        """
+        seen = set() if seen is None else seen
+        if clazz.qname in seen:
+            return False
+        seen.add(clazz.qname)
+
+        attrs = list(clazz.attrs)
+        attrs += [choice for attr in clazz.attrs for choice in attr.choices]
+        if any(self.is_abstract_attr(attr) for attr in attrs):
+            return True
+
+        qnames = [ex.type.qname for ex in clazz.extensions]
+        qnames += [t.qname for attr in attrs for t in attr.types if not t.native]
+        return any(
+            self.cls_shares_members(self.resolver.class_map[qname], seen)
+            for qname in qnames
+            if qname in self.resolver.class_map
+        )
+
     def is_abstract_ext(self, ext: Extension) -> str:
         """return true if this parent (extension) is referencing an abstract
         base class.
@@ -947,6 +1174,27 @@ class AgFilters:
                 return value.is_enumeration
         return False
 
+    def is_numeric_list_attr(self, attr: Attr) -> bool:
+        """return true if the member is a list of native numbers, stored contiguously
+        in a std::vector of a fundamental type (e.g. exposed as numpy arrays).
+        """
+        return (
+            attr.is_list
+            and self.is_native_attr(attr)
+            and self.raw_type_name(attr) in AgFilters.NUMERIC_CPP_TYPES
+        )
+
+    def is_numeric_attr(self, attr: Attr) -> bool:
+        """return true if the member is a single, always set native number
+        (e.g. a column of a numpy array).
+        """
+        return (
+            not attr.is_list
+            and not self.is_optional_attr(attr)
+            and self.is_native_attr(attr)
+            and self.raw_type_name(attr) in AgFilters.NUMERIC_CPP_TYPES
+        )
+
     def is_optional_attr(self, attr: Attr) -> bool:
         """return true if the member can have no value.
 
@@ -986,7 +1234,9 @@ class AgFilters:
         includes = []
         if attr.is_list:
             includes.append("<vector>")
-            if self.is_custom_attr(attr):
+            if self.is_compound_attr(attr):
+                pass  # forward declared, see can_fwd_decl
+            elif self.is_custom_attr(attr):
                 includes.append(self.__rendered_qname_include(attr.types[0].qname))
             elif not self.is_native_attr(attr):
                 type_name = self.raw_type_name(attr)
@@ -994,9 +1244,13 @@ class AgFilters:
                     includes.append(f'<{"/".join(type_name.split("::"))}.h>')
                 else:
                     includes.append(f'"{type_name}.h"')
+            else:
+                includes.append(self.native_include(attr))
         elif attr.is_optional:
             includes.append("<optional>")
-            if self.is_custom_attr(attr):
+            if self.is_compound_attr(attr):
+                pass  # forward declared, see can_fwd_decl
+            elif self.is_custom_attr(attr):
                 includes.append(self.__rendered_qname_include(attr.types[0].qname))
             elif not self.is_native_attr(attr):
                 type_name = self.raw_type_name(attr)
@@ -1004,6 +1258,8 @@ class AgFilters:
                     includes.append(f'<{"/".join(type_name.split("::"))}.h>')
                 else:
                     includes.append(f'"{type_name}.h"')
+            else:
+                includes.append(self.native_include(attr))
         elif self.is_abstract_attr(attr):
             includes.append("<memory>")
         elif self.is_native_attr(attr):
@@ -144,6 +144,7 @@ class ApiClassGenerator(DataclassGenerator):
                 "ns_package": "::".join(package.split(".")),
                 "path_package": "/".join(package.split(".")),
                 "ns_bytestream": "::".join(package.split(".")[:-1] + ["byte_stream"]),
+                "cache_serialized": self.settings.cache_serialized,
             }
 
             render_args.update(
@@ -220,12 +221,19 @@ class ApiClassGenerator(DataclassGenerator):
             ]
         )
 
-        templates = [tpl for tpl in self.env.list_templates() if tpl.startswith(subdir)]
+        templates = [
+            tpl for tpl in self.env.list_templates() if tpl.startswith(f"{subdir}/")
+        ]
 
         print(f"module: {subdir} has {len(templates)} templates:")
         for tpl in templates:
             print(f"\t{tpl}")
 
+        # per class outputs keyed by template package, unity bundles are rendered
+        # after every class template so they can include those outputs
+        rendered_paths = {}
+        unity_templates = []
+
         for template in templates:
             template_subdir = (
                 subdir if template not in test_templates else f"{subdir}/test"
@@ -243,6 +251,10 @@ class ApiClassGenerator(DataclassGenerator):
                 if tpl.filter == "utils" and self.settings.utils_ns:
                     print(f"Skipping {tpl.path} from --utils-ns setting.")
                     continue
+                if tpl.filter == "unity":
+                    if self.settings.unity_batch_size > 0:
+                        unity_templates.append((tpl, tpl_args))
+                    continue
                 print(f"{tpl.path} -> {tpl.to_path()}")
                 yield (
                     tpl,
@@ -256,6 +268,7 @@ class ApiClassGenerator(DataclassGenerator):
                     tpl_context = tpl.apply_filter(obj_type, obj, mapper)
                     if tpl_context != None:
                         tpl_context.update({"type_name": obj.name, "type_info": obj})
+                        obj_path = tpl.to_path(type_name=obj.name)
                         yield (
                             tpl,
                             self.render_template(
@@ -264,13 +277,70 @@ class ApiClassGenerator(DataclassGenerator):
                                 **render_args,
                                 **tpl_args,
                             ),
-                            tpl.to_path(type_name=obj.name),
+                            obj_path,
+                        )
+                        rendered_paths.setdefault(tuple(tpl.package), []).append(
+                            obj_path
                         )
                         class_count += 1
                 print(
                     f'{tpl.path} for {tpl.class_type} rendered: {class_count} as {tpl.to_path(type_name="{{type_name}}")}'
                 )
 
+        for tpl, tpl_args in unity_templates:
+            yield from self.render_unity(tpl, rendered_paths, render_args, tpl_args)
+
+    def render_unity(
+        self,
+        tpl: TemplateDef,
+        rendered_paths: Dict[Tuple[str, ...], List[str]],
+        render_args: Dict[str, Any],
+        tpl_args: Dict[str, Any],
+    ) -> Iterator[Tuple[TemplateDef, str, str]]:
+        """Render a global template filtered by "unity" (see --unity arg in __main__.py).
+
+        If the filename pattern includes {unity_index} the template is rendered once per
+        batch of per class outputs with a matching extension in the same package, the
+        batch is available in template scope as `unity_sources` (paths relative to
+        the package). Otherwise it is rendered once, like any other global (e.g. a
+        precompiled header).
+        """
+        if "{unity_index}" not in tpl.format_pattern:
+            print(f"{tpl.path} -> {tpl.to_path()}")
+            yield (
+                tpl,
+                self.render_template(tpl.path, **render_args, **tpl_args),
+                tpl.to_path(),
+            )
+            return
+
+        prefix = "/".join(tpl.package)
+        sources = [
+            path.removeprefix(f"{prefix}/") if prefix else path
+            for path in rendered_paths.get(tuple(tpl.package), [])
+            if path.endswith(f".{tpl.ext}")
+        ]
+        batch_size = self.settings.unity_batch_size
+        batches = [
+            sources[idx : idx + batch_size]
+            for idx in range(0, len(sources), batch_size)
+        ]
+        for unity_index, unity_sources in enumerate(batches):
+            yield (
+                tpl,
+                self.render_template(
+                    tpl.path,
+                    unity_index=unity_index,
+                    unity_sources=unity_sources,
+                    **render_args,
+                    **tpl_args,
+                ),
+                tpl.to_path(unity_index=unity_index),
+            )
+        print(
+            f"{tpl.path} for unity rendered: {len(batches)} from {len(sources)} sources as {tpl.to_path(unity_index='{{unity_index}}')}"
+        )
+
     def render_template(self, tpl_path: str, **kwargs) -> str:
         """Render the source code of the classes."""
         template = self.env.get_template(tpl_path)
@@ -26,6 +26,10 @@ class FilterMethods:
         else:
             return None
 
+    @staticmethod
+    def is_concrete(obj: Class, mapper: AbstractMapper):
+        return None if FilterMethods.is_abstract(obj, mapper) else {}
+
     @staticmethod
     def is_variant(obj: Class, _mapper: AbstractMapper):
         return (
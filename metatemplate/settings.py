@@ -24,6 +24,8 @@ class TemplateSpec:
 class Settings:
     root_repo: str = None
     utils_ns: str = None
+    unity_batch_size: int = 0
+    cache_serialized: bool = False
     specs: List[TemplateSpec] = field(
         default_factory=lambda: [
             TemplateSpec(key="api", namespace=["metatemplate.api"]),
@@ -35,8 +37,10 @@ class Settings:
             ),
             TemplateSpec(key="protobuf", namespace=["metatemplate.protobuf"]),
             TemplateSpec(
-                key="protobuf_converters", namespace=["metatemplate.protobuf_converters"]
+                key="protobuf_converters",
+                namespace=["metatemplate.protobuf_converters"],
             ),
+            TemplateSpec(key="arrow", namespace=["metatemplate.arrow"]),
         ]
     )
 
@@ -0,0 +1,28 @@
+#pragma once
+
+// Precompiled header for the {{ns_package}} library, only the stable
+// std and utils headers shared by most of the generated sources belong here,
+// never a generated type header (any schema change would invalidate it).
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+#include {{"utils/Clock.h" | util_ns.incl}}
+#include {{"utils/UUID.h" | util_ns.incl}}
+#include {{"utils/EssentiallyEqual.h" | util_ns.incl}}
+#include {{"utils/Stream.h" | util_ns.incl}}
+#include {{"byte_stream/ByteStream.h" | util_ns.incl}}
+#include {{"json/Json.h" | util_ns.incl}}
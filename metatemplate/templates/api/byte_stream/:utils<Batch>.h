@@ -0,0 +1,237 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "{{path_package}}/byte_stream/ByteStream.h"
+
+namespace {{ns_tpl}}
+{
+	// Batch encoding of many messages into one buffer:
+	//   uint64 count | uint64 offsets[count + 1] | payload
+	// offsets are relative to the payload start, message i is payload[offsets[i], offsets[i + 1]).
+	// Works for any byte stream type, std::shared_ptr of an abstract base type makes a
+	// heterogeneous batch (each message carries its class ID).
+	namespace batch_impl
+	{
+		/**
+		 * @brief Below this many messages per thread a batch is not split
+		 */
+		inline constexpr std::size_t MIN_PER_THREAD = 256;
+
+		/**
+		 * @brief Number of threads to split count items over
+		 *
+		 * @param count: number of items
+		 * @param threads: requested threads, 0 for the hardware concurrency
+		 * @returns std::size_t at least 1
+		 */
+		[[nodiscard]] inline std::size_t threadCount(std::size_t count, std::size_t threads)
+		{
+			if(threads == 0)
+			{
+				threads = std::max<std::size_t>(1, std::thread::hardware_concurrency());
+			}
+			return std::max<std::size_t>(1, std::min(threads, count / MIN_PER_THREAD));
+		}
+
+		/**
+		 * @brief Calls func(chunk, begin, end) for contiguous chunks of [0, count), the
+		 * first chunk on the calling thread. Rethrows the first exception of a chunk.
+		 */
+		template <typename Func>
+		void parallelFor(std::size_t count, std::size_t chunks, Func&& func)
+		{
+			if(chunks <= 1)
+			{
+				func(std::size_t{ 0 }, std::size_t{ 0 }, count);
+				return;
+			}
+
+			std::vector<std::exception_ptr> errors(chunks);
+			std::vector<std::thread> workers;
+			workers.reserve(chunks - 1);
+			const auto run = [&](std::size_t chunk) {
+				try
+				{
+					func(chunk, count * chunk / chunks, count * (chunk + 1) / chunks);
+				}
+				catch(...)
+				{
+					errors[chunk] = std::current_exception();
+				}
+			};
+			for(std::size_t chunk = 1; chunk < chunks; ++chunk)
+			{
+				workers.emplace_back(run, chunk);
+			}
+			run(0);
+			for(auto& worker : workers)
+			{
+				worker.join();
+			}
+			for(const auto& error : errors)
+			{
+				if(error)
+				{
+					std::rethrow_exception(error);
+				}
+			}
+		}
+
+		/**
+		 * @brief Patches an entry of the reserved offset table, skipped once the stream
+		 * overflowed (the table may not have been reserved)
+		 */
+		inline void writeSize(OByteStream& bs, std::size_t pos, bytestream_impl::SizeType value)
+		{
+			if(bs.ok())
+			{
+				bytestream_impl::writeLittleEndian(bs.data() + pos, &value, 1);
+			}
+		}
+
+		[[nodiscard]] inline bytestream_impl::SizeType readSize(const std::byte* buffer)
+		{
+			bytestream_impl::SizeType value;
+			bytestream_impl::readLittleEndian(&value, buffer, 1);
+			return value;
+		}
+	} // namespace batch_impl
+
+	/**
+	 * @brief Appends count messages to the stream as one batch
+	 *
+	 * @param values: the first message
+	 * @param count: number of messages
+	 * @param bs: the stream to append to
+	 * @param threads: encode threads for large batches, 1 (default) stays on the calling thread, 0 uses all cores
+	 */
+	template <typename T>
+	void serializeBatch(const T* values, std::size_t count, OByteStream& bs, std::size_t threads = 1)
+	{
+		using SizeType = bytestream_impl::SizeType;
+		const std::size_t chunks = batch_impl::threadCount(count, threads);
+
+		bs << static_cast<SizeType>(count);
+		const std::size_t offsetsPos = bs.size();
+		bs.reserveBytes(sizeof(SizeType) * (count + 1));
+		const std::size_t payloadPos = bs.size();
+
+		if(chunks <= 1)
+		{
+			for(std::size_t i = 0; i < count; ++i)
+			{
+				batch_impl::writeSize(bs, offsetsPos + sizeof(SizeType) * i, bs.size() - payloadPos);
+				bs << values[i];
+			}
+		}
+		else
+		{
+			std::vector<OByteStream> parts(chunks);
+			std::vector<std::vector<std::size_t>> partOffsets(chunks);
+			batch_impl::parallelFor(count, chunks, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+				partOffsets[chunk].reserve(end - begin);
+				for(std::size_t i = begin; i < end; ++i)
+				{
+					partOffsets[chunk].push_back(parts[chunk].size());
+					parts[chunk] << values[i];
+				}
+			});
+
+			std::size_t index = 0;
+			for(std::size_t chunk = 0; chunk < chunks; ++chunk)
+			{
+				const std::size_t base = bs.size() - payloadPos;
+				for(const auto offset : partOffsets[chunk])
+				{
+					batch_impl::writeSize(bs, offsetsPos + sizeof(SizeType) * index++, base + offset);
+				}
+				bs.writeBytes(parts[chunk].data(), parts[chunk].size());
+			}
+		}
+		batch_impl::writeSize(bs, offsetsPos + sizeof(SizeType) * count, bs.size() - payloadPos);
+	}
+
+	/**
+	 * @brief Serializes the messages as one batch
+	 *
+	 * @param values: the messages
+	 * @param threads: encode threads for large batches, 1 (default) stays on the calling thread, 0 uses all cores
+	 * @return std::vector<std::byte>
+	 */
+	template <typename T>
+	[[nodiscard]] std::vector<std::byte> serializeBatch(const std::vector<T>& values, std::size_t threads = 1)
+	{
+		OByteStream bs;
+		serializeBatch(values.data(), values.size(), bs, threads);
+		return bs.release();
+	}
+
+	/**
+	 * @brief Decodes a batch written by serializeBatch, existing elements of output are
+	 * reused (decoded in place).
+	 *
+	 * @param buffer: the batch bytes
+	 * @param size: number of bytes
+	 * @param output: resized to the batch count
+	 * @param threads: decode threads for large batches, 1 (default) stays on the calling thread, 0 uses all cores
+	 * @throws std::runtime_error if the batch is malformed
+	 */
+	template <typename T>
+	void deserializeBatch(const std::byte* buffer, std::size_t size, std::vector<T>& output, std::size_t threads = 1)
+	{
+		using SizeType = bytestream_impl::SizeType;
+		if(size < sizeof(SizeType))
+		{
+			throw std::runtime_error("batch buffer too small for the message count");
+		}
+		const SizeType count = batch_impl::readSize(buffer);
+		if(count >= (size - sizeof(SizeType)) / sizeof(SizeType))
+		{
+			throw std::runtime_error("batch buffer too small for " + std::to_string(count) + " message offsets");
+		}
+		const std::byte* offsets = buffer + sizeof(SizeType);
+		const std::byte* payload = offsets + sizeof(SizeType) * (count + 1);
+		const std::size_t payloadSize = size - static_cast<std::size_t>(payload - buffer);
+
+		output.resize(static_cast<std::size_t>(count));
+		batch_impl::parallelFor(output.size(), batch_impl::threadCount(output.size(), threads), [&](std::size_t, std::size_t begin, std::size_t end) {
+			for(std::size_t i = begin; i < end; ++i)
+			{
+				const SizeType first = batch_impl::readSize(offsets + sizeof(SizeType) * i);
+				const SizeType last = batch_impl::readSize(offsets + sizeof(SizeType) * (i + 1));
+				if(first > last || last > payloadSize)
+				{
+					throw std::runtime_error("batch message " + std::to_string(i) + " is out of the buffer bounds");
+				}
+				IByteStream bs(payload + first, static_cast<std::size_t>(last - first));
+				bs >> output[i];
+				if(!bs.ok())
+				{
+					throw std::runtime_error("batch message " + std::to_string(i) + " failed to decode");
+				}
+			}
+		});
+	}
+
+	/**
+	 * @brief Decodes a batch written by serializeBatch
+	 *
+	 * @param bytes: the batch bytes
+	 * @param output: resized to the batch count
+	 * @param threads: decode threads for large batches, 1 (default) stays on the calling thread, 0 uses all cores
+	 * @throws std::runtime_error if the batch is malformed
+	 */
+	template <typename T>
+	void deserializeBatch(const std::vector<std::byte>& bytes, std::vector<T>& output, std::size_t threads = 1)
+	{
+		deserializeBatch(bytes.data(), bytes.size(), output, threads);
+	}
+} // namespace {{ns_tpl}}
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace {{ns_tpl}}
+{
+	/**
+	 * @brief Thread local pool of serialization buffers, a released buffer keeps its
+	 * capacity so steady state encoding doesn't allocate.
+	 *
+	 * auto buffer = BufferPool::acquire();
+	 * message.serializeInto(*buffer);
+	 * publish(buffer->data(), buffer->size());
+	 */
+	class BufferPool
+	{
+	public:
+		/**
+		 * @brief Buffers kept per thread, extra released buffers are freed
+		 */
+		static constexpr std::size_t MAX_POOLED = 8;
+
+		/**
+		 * @brief Pooled buffer, returned to the pool of the destroying thread
+		 */
+		class Lease
+		{
+		public:
+			explicit Lease(std::vector<std::byte>&& buffer) noexcept : buffer_(std::move(buffer))
+			{
+			}
+
+			Lease(Lease&& other) noexcept = default;
+			Lease& operator=(Lease&& other) noexcept = default;
+			Lease(const Lease&) = delete;
+			Lease& operator=(const Lease&) = delete;
+
+			~Lease()
+			{
+				if(buffer_.capacity() > 0)
+				{
+					BufferPool::release(std::move(buffer_));
+				}
+			}
+
+			std::vector<std::byte>& operator*() noexcept
+			{
+				return buffer_;
+			}
+
+			std::vector<std::byte>* operator->() noexcept
+			{
+				return &buffer_;
+			}
+
+		private:
+			std::vector<std::byte> buffer_;
+		};
+
+		/**
+		 * @brief Takes an empty buffer from the pool of the calling thread
+		 *
+		 * @param capacity: minimum capacity of the buffer
+		 * @return Lease
+		 */
+		[[nodiscard]] static Lease acquire(std::size_t capacity = 0)
+		{
+			auto& buffers = pool();
+			std::vector<std::byte> buffer;
+			if(!buffers.empty())
+			{
+				buffer = std::move(buffers.back());
+				buffers.pop_back();
+			}
+			buffer.reserve(capacity);
+			return Lease(std::move(buffer));
+		}
+
+	private:
+		static std::vector<std::vector<std::byte>>& pool()
+		{
+			thread_local std::vector<std::vector<std::byte>> buffers = [] {
+				std::vector<std::vector<std::byte>> reserved;
+				reserved.reserve(MAX_POOLED);
+				return reserved;
+			}();
+			return buffers;
+		}
+
+		static void release(std::vector<std::byte>&& buffer)
+		{
+			auto& buffers = pool();
+			if(buffers.size() < MAX_POOLED)
+			{
+				buffer.clear();
+				buffers.push_back(std::move(buffer));
+			}
+		}
+	};
+} // namespace {{ns_tpl}}
@@ -46,13 +46,19 @@ SOFTWARE.
 // assert(x1 == x2 && v1 == v2);
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cstdint>
+#include <cstring>
+#include <limits>
 #include <memory>
 #include <optional>
+#include <stdexcept>
 #include <string>
 #include <string_view>
 #include <tuple>
 #include <type_traits>
+#include <variant>
 #include <vector>
 
 #include "{{path_package}}/utils/Clock.h"
@@ -67,9 +73,100 @@ namespace {{ns_tpl}}
 		enum class Status
 		{
 			OK,
-			INVALID_READ
+			INVALID_READ,
+			WRITE_OVERFLOW
 		};
 
+		/**
+		 * @brief Whether decoded values are checked against the alias restrictions, TRUSTED
+		 * skips the checks for data written by our own peers.
+		 */
+		enum class Trust
+		{
+			UNTRUSTED,
+			TRUSTED
+		};
+
+		// The wire format is little-endian with fixed width lengths (uint64), on little-endian
+		// hosts every conversion below compiles down to the plain copy.
+#if defined(__BYTE_ORDER__) && defined(__ORDER_BIG_ENDIAN__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+		inline constexpr bool LITTLE_ENDIAN_HOST = false;
+#else
+		inline constexpr bool LITTLE_ENDIAN_HOST = true;
+#endif
+
+		/**
+		 * @brief Length prefix type of strings and containers on the wire
+		 */
+		using SizeType = std::uint64_t;
+
+		/**
+		 * @brief Reverses the byte order of a fundamental or enum value
+		 */
+		template <typename T>
+		[[nodiscard]] T byteSwap(T value) noexcept
+		{
+#if defined(__GNUC__) || defined(__clang__)
+			// the builtins let the compiler vectorize bulk swaps of primitive vectors
+			if constexpr(sizeof(T) == 2 || sizeof(T) == 4 || sizeof(T) == 8)
+			{
+				using Bits = std::conditional_t<sizeof(T) == 2, std::uint16_t, std::conditional_t<sizeof(T) == 4, std::uint32_t, std::uint64_t>>;
+				Bits bits;
+				std::memcpy(&bits, &value, sizeof(T));
+				if constexpr(sizeof(T) == 2)
+					bits = __builtin_bswap16(bits);
+				else if constexpr(sizeof(T) == 4)
+					bits = __builtin_bswap32(bits);
+				else
+					bits = __builtin_bswap64(bits);
+				std::memcpy(&value, &bits, sizeof(T));
+				return value;
+			}
+#endif
+			std::byte bytes[sizeof(T)];
+			std::memcpy(bytes, &value, sizeof(T));
+			std::reverse(bytes, bytes + sizeof(T));
+			std::memcpy(&value, bytes, sizeof(T));
+			return value;
+		}
+
+		/**
+		 * @brief Writes count fundamental/enum values in wire (little-endian) byte order
+		 */
+		template <typename T>
+		void writeLittleEndian(void* dst, const T* values, size_t count)
+		{
+			if constexpr(LITTLE_ENDIAN_HOST || sizeof(T) == 1)
+			{
+				std::memcpy(dst, values, count * sizeof(T));
+			}
+			else
+			{
+				auto* out = static_cast<std::byte*>(dst);
+				for(size_t i = 0; i < count; ++i)
+				{
+					const T swapped = byteSwap(values[i]);
+					std::memcpy(out + i * sizeof(T), &swapped, sizeof(T));
+				}
+			}
+		}
+
+		/**
+		 * @brief Reads count fundamental/enum values from wire (little-endian) byte order
+		 */
+		template <typename T>
+		void readLittleEndian(T* values, const void* src, size_t count)
+		{
+			std::memcpy(values, src, count * sizeof(T));
+			if constexpr(!LITTLE_ENDIAN_HOST && sizeof(T) > 1)
+			{
+				for(size_t i = 0; i < count; ++i)
+				{
+					values[i] = byteSwap(values[i]);
+				}
+			}
+		}
+
 		inline void writePrimitiveType(void* dst, const void* value, size_t size)
 		{
 			std::copy_n((const std::byte*)value, size, (std::byte*)dst);
@@ -120,8 +217,10 @@ namespace {{ns_tpl}}
 		class CanPushBack : public std::false_type
 		{
 		};
+		// containers with their own fromByteStream (e.g. the generated Columns) read themselves
 		template <typename T>
-		class CanPushBack<T, std::void_t<decltype(std::declval<T>().push_back(std::declval<typename T::value_type&&>()))>> : public std::true_type
+		class CanPushBack<T, std::void_t<decltype(std::declval<T>().push_back(std::declval<typename T::value_type&&>()))>>
+			: public std::bool_constant<!HasFromBytestream<T>::value>
 		{
 		};
 
@@ -138,11 +237,308 @@ namespace {{ns_tpl}}
 			using type = std::pair<T1, T2>;
 		};
 
+		/**
+		 * @brief Types whose in memory bytes on a little-endian host are their wire bytes,
+		 * containers of them are written/read with a single copy.
+		 *
+		 * Generated aliases over such a type opt in with a static BULK_COPYABLE member.
+		 */
+		template <typename T, typename = void>
+		class IsBulkCopyable : public std::bool_constant<(std::is_fundamental_v<T> || std::is_enum_v<T>) && !std::is_same_v<T, bool>>
+		{
+		};
+		template <typename T>
+		class IsBulkCopyable<T, std::enable_if_t<T::BULK_COPYABLE>>
+		    : public std::bool_constant<std::is_trivially_copyable_v<T> && sizeof(T) == sizeof(typename T::alias_type)
+		                                && IsBulkCopyable<typename T::alias_type>::value>
+		{
+		};
+		template <>
+		class IsBulkCopyable<utils::UUID> : public std::bool_constant<std::is_trivially_copyable_v<utils::UUID> && sizeof(utils::UUID) == 16>
+		{
+		};
+		template <>
+		class IsBulkCopyable<utils::Duration> : public std::bool_constant<sizeof(utils::Duration) == sizeof(std::int64_t)>
+		{
+		};
+		template <>
+		class IsBulkCopyable<utils::TimePoint> : public std::bool_constant<sizeof(utils::TimePoint) == sizeof(std::int64_t)>
+		{
+		};
+
+		template <typename T, typename = void>
+		class IsCheckedAlias : public std::false_type
+		{
+		};
+		template <typename T>
+		class IsCheckedAlias<T, std::void_t<typename T::alias_type, decltype(std::declval<T&>().setValue(std::declval<const T&>().getValue()))>>
+		    : public std::true_type
+		{
+		};
+
+		template <typename T, typename = void>
+		class HasValidateRestrictions : public std::false_type
+		{
+		};
+		template <typename T>
+		class HasValidateRestrictions<T, std::void_t<decltype(std::declval<const T&>().validateRestrictions())>> : public std::true_type
+		{
+		};
+
+		/**
+		 * @brief Applies the alias restrictions to a decoded struct member, the pass a struct
+		 * runs over all of its fields once read (see IByteStream::Trust). Lists of aliases are
+		 * checked with the alias allValid loop and only walked again to report a failure.
+		 */
+		template <typename T, typename = void>
+		class RestrictionValidator
+		{
+		public:
+			static void validate(const T&)
+			{
+			}
+		};
+		template <typename T>
+		class RestrictionValidator<T, std::enable_if_t<HasValidateRestrictions<T>::value>>
+		{
+		public:
+			static void validate(const T& value)
+			{
+				value.validateRestrictions();
+			}
+		};
+		template <typename T>
+		class RestrictionValidator<T, std::enable_if_t<IsCheckedAlias<T>::value>>
+		{
+		public:
+			static void validate(const T& value)
+			{
+				value.validate();
+			}
+		};
+
+		/**
+		 * @brief Validates count contiguous values
+		 *
+		 * @throws std::invalid_argument from the first value failing its restrictions
+		 */
+		template <typename T>
+		void validateRestrictions(const T* values, std::size_t count)
+		{
+			if constexpr(IsCheckedAlias<T>::value)
+			{
+				if(T::allValid(values, count))
+				{
+					return;
+				}
+			}
+			if constexpr(!std::is_fundamental_v<T> && !std::is_enum_v<T>)
+			{
+				for(std::size_t i = 0; i < count; ++i)
+				{
+					RestrictionValidator<T>::validate(values[i]);
+				}
+			}
+		}
+
+		template <typename T>
+		class RestrictionValidator<std::optional<T>>
+		{
+		public:
+			static void validate(const std::optional<T>& value)
+			{
+				if(value)
+				{
+					RestrictionValidator<T>::validate(*value);
+				}
+			}
+		};
+		template <typename T>
+		class RestrictionValidator<std::shared_ptr<T>>
+		{
+		public:
+			static void validate(const std::shared_ptr<T>& value)
+			{
+				if(value)
+				{
+					RestrictionValidator<T>::validate(*value);
+				}
+			}
+		};
+		template <typename T, typename Allocator>
+		class RestrictionValidator<std::vector<T, Allocator>>
+		{
+		public:
+			static void validate(const std::vector<T, Allocator>& values)
+			{
+				if constexpr(!std::is_same_v<T, bool>)
+				{
+					validateRestrictions(values.data(), values.size());
+				}
+			}
+		};
+		template <typename T, std::size_t N>
+		class RestrictionValidator<std::array<T, N>>
+		{
+		public:
+			static void validate(const std::array<T, N>& values)
+			{
+				validateRestrictions(values.data(), N);
+			}
+		};
+		template <typename... T>
+		class RestrictionValidator<std::variant<T...>>
+		{
+		public:
+			static void validate(const std::variant<T...>& value)
+			{
+				if(!value.valueless_by_exception())
+				{
+					std::visit([](const auto& held) { RestrictionValidator<std::decay_t<decltype(held)>>::validate(held); }, value);
+				}
+			}
+		};
+
+		/**
+		 * @brief Applies the alias restrictions to a decoded struct member
+		 *
+		 * @param value: the member
+		 * @throws std::invalid_argument if a restriction fails
+		 */
+		template <typename T>
+		void validateRestrictions(const T& value)
+		{
+			RestrictionValidator<T>::validate(value);
+		}
+
+		/**
+		 * @brief Hands out increasing revisions for the serialized cache of generated structs
+		 * (--cache-serialized), 0 is never returned so it can mark an empty cache.
+		 *
+		 * @returns std::uint64_t
+		 */
+		inline std::uint64_t nextSerializedRevision() noexcept
+		{
+			static std::atomic<std::uint64_t> revision{ 0 };
+			return revision.fetch_add(1, std::memory_order_relaxed) + 1;
+		}
+
+		template <typename T, typename = void>
+		class HasSerializedRevision : public std::false_type
+		{
+		};
+		template <typename T>
+		class HasSerializedRevision<T, std::void_t<decltype(std::declval<const T&>().serializedRevision())>> : public std::true_type
+		{
+		};
+
+		/**
+		 * @brief Revision of a struct member for the serialized cache, the newest revision
+		 * of any generated struct it holds, 0 for untracked values.
+		 */
+		template <typename T, typename = void>
+		class SerializedRevision
+		{
+		public:
+			static std::uint64_t get(const T&) noexcept
+			{
+				return 0;
+			}
+		};
+		template <typename T>
+		class SerializedRevision<T, std::enable_if_t<HasSerializedRevision<T>::value>>
+		{
+		public:
+			static std::uint64_t get(const T& value) noexcept
+			{
+				return value.serializedRevision();
+			}
+		};
+		template <typename T>
+		class SerializedRevision<std::optional<T>>
+		{
+		public:
+			static std::uint64_t get(const std::optional<T>& value) noexcept
+			{
+				return value ? SerializedRevision<T>::get(*value) : 0;
+			}
+		};
+		template <typename T>
+		class SerializedRevision<std::shared_ptr<T>>
+		{
+		public:
+			static std::uint64_t get(const std::shared_ptr<T>& value) noexcept
+			{
+				return value ? SerializedRevision<T>::get(*value) : 0;
+			}
+		};
+		template <typename T, typename Allocator>
+		class SerializedRevision<std::vector<T, Allocator>>
+		{
+		public:
+			static std::uint64_t get(const std::vector<T, Allocator>& values) noexcept
+			{
+				std::uint64_t revision = 0;
+				if constexpr(!std::is_fundamental_v<T> && !std::is_enum_v<T>)
+				{
+					for(const auto& value : values)
+					{
+						revision = std::max(revision, SerializedRevision<T>::get(value));
+					}
+				}
+				return revision;
+			}
+		};
+		template <typename T, std::size_t N>
+		class SerializedRevision<std::array<T, N>>
+		{
+		public:
+			static std::uint64_t get(const std::array<T, N>& values) noexcept
+			{
+				std::uint64_t revision = 0;
+				if constexpr(!std::is_fundamental_v<T> && !std::is_enum_v<T>)
+				{
+					for(const auto& value : values)
+					{
+						revision = std::max(revision, SerializedRevision<T>::get(value));
+					}
+				}
+				return revision;
+			}
+		};
+		template <typename... Ts>
+		class SerializedRevision<std::variant<Ts...>>
+		{
+		public:
+			static std::uint64_t get(const std::variant<Ts...>& value) noexcept
+			{
+				if(value.valueless_by_exception())
+				{
+					return 0;
+				}
+				return std::visit([](const auto& held) { return SerializedRevision<std::decay_t<decltype(held)>>::get(held); }, value);
+			}
+		};
+
+		/**
+		 * @brief Newest serialized revision of a struct member
+		 *
+		 * @param value: the member
+		 * @returns std::uint64_t
+		 */
+		template <typename T>
+		[[nodiscard]] std::uint64_t serializedRevision(const T& value) noexcept
+		{
+			return SerializedRevision<T>::get(value);
+		}
+
 	} // namespace bytestream_impl
 
 	class OByteStream
 	{
 	public:
+		using Status = bytestream_impl::Status;
+
 		OByteStream(size_t capacity = 0)
 		{
 			if(capacity > 0)
@@ -151,13 +547,77 @@ namespace {{ns_tpl}}
 			}
 		}
 
+		/**
+		 * @brief Writes into an existing buffer, its content is dropped but its capacity reused
+		 *
+		 * @param buffer: the buffer to adopt
+		 */
+		explicit OByteStream(std::vector<std::byte>&& buffer) : outputBytes_(std::move(buffer))
+		{
+			outputBytes_.clear();
+		}
+
+		/**
+		 * @brief Writes in place into a caller owned buffer that never grows, once a write
+		 * doesn't fit nothing more is written and the status is WRITE_OVERFLOW
+		 *
+		 * @param buffer: the buffer to write to
+		 * @param capacity: size of the buffer
+		 */
+		OByteStream(std::byte* buffer, std::size_t capacity) : fixed_(buffer), fixedCapacity_(capacity)
+		{
+		}
+
+		/**
+		 * @brief Drops the written bytes, keeps the capacity for the next message
+		 */
+		void reset() noexcept
+		{
+			outputBytes_.clear();
+			fixedSize_ = 0;
+			status_ = Status::OK;
+		}
+
+		Status getStatus() const
+		{
+			return status_;
+		}
+		bool ok() const
+		{
+			return status_ == Status::OK;
+		}
+
+		/**
+		 * @brief The written bytes, in the caller's buffer when writing in place
+		 */
+		const std::byte* data() const
+		{
+			return fixed_ != nullptr ? fixed_ : outputBytes_.data();
+		}
+		std::byte* data()
+		{
+			return fixed_ != nullptr ? fixed_ : outputBytes_.data();
+		}
+
+		/**
+		 * @brief Moves the written bytes out of the stream, leaving it empty. Like buffer()
+		 * and getBytes() only for streams that own their bytes.
+		 *
+		 * @throws std::logic_error for an in place stream
+		 * @return std::vector<std::byte>
+		 */
+		[[nodiscard]] std::vector<std::byte> release()
+		{
+			return std::move(ownedBytes());
+		}
+
 		const std::vector<std::byte>& getBytes() const
 		{
-			return outputBytes_;
+			return ownedBytes();
 		}
 		std::vector<std::byte>& getMutableBytes()
 		{
-			return outputBytes_;
+			return ownedBytes();
 		}
 
 		template <typename T>
@@ -169,42 +629,148 @@ namespace {{ns_tpl}}
 
 		const std::vector<std::byte>& buffer() const
 		{
-			return outputBytes_;
+			return ownedBytes();
 		}
 		std::vector<std::byte>& buffer()
 		{
-			return outputBytes_;
+			return ownedBytes();
+		}
+
+		std::size_t size() const
+		{
+			return fixed_ != nullptr ? fixedSize_ : outputBytes_.size();
+		}
+
+		/**
+		 * @brief Appends already serialized bytes, e.g. a cached encoding
+		 *
+		 * @param bytes: start of the serialized bytes
+		 * @param size: number of bytes
+		 */
+		void writeBytes(const std::byte* bytes, std::size_t size)
+		{
+			if(auto* out = grow(size); out != nullptr && size > 0)
+			{
+				bytestream_impl::writeBuffer(out, bytes, size);
+			}
+		}
+
+		/**
+		 * @brief Appends size bytes to be filled in later through data(), e.g. an offset table
+		 * written before the payload it points into. Zeroed for streams that own their bytes.
+		 *
+		 * @param size: number of bytes
+		 */
+		void reserveBytes(std::size_t size)
+		{
+			grow(size);
 		}
 
 	private:
+		const std::vector<std::byte>& ownedBytes() const
+		{
+			if(fixed_ != nullptr)
+			{
+				throw std::logic_error("OByteStream: an in place stream has no byte vector, use data()/size()");
+			}
+			return outputBytes_;
+		}
+		std::vector<std::byte>& ownedBytes()
+		{
+			if(fixed_ != nullptr)
+			{
+				throw std::logic_error("OByteStream: an in place stream has no byte vector, use data()/size()");
+			}
+			return outputBytes_;
+		}
+
+		/**
+		 * @brief Room for size more bytes at the end, nullptr once an in place stream overflowed
+		 */
+		std::byte* grow(std::size_t size)
+		{
+			if(fixed_ == nullptr)
+			{
+				const size_t size0 = outputBytes_.size();
+				outputBytes_.resize(size0 + size);
+				return outputBytes_.data() + size0;
+			}
+			if(status_ != Status::OK || size > fixedCapacity_ - fixedSize_)
+			{
+				status_ = Status::WRITE_OVERFLOW;
+				return nullptr;
+			}
+			auto* out = fixed_ + fixedSize_;
+			fixedSize_ += size;
+			return out;
+		}
+
 		void write(const std::string_view& input)
 		{
-			const size_t size0 = outputBytes_.size();
-			const size_t size1 = input.size();
-			outputBytes_.resize(size0 + sizeof(size_t) + size1);
-			bytestream_impl::writePrimitiveType(&outputBytes_[size0], &size1, sizeof(size_t));
-			bytestream_impl::writeBuffer(&outputBytes_[size0 + sizeof(size_t)], input.data(), input.size());
+			using SizeType = bytestream_impl::SizeType;
+			const auto size1 = static_cast<SizeType>(input.size());
+			if(auto* out = grow(sizeof(SizeType) + input.size()))
+			{
+				bytestream_impl::writeLittleEndian(out, &size1, 1);
+				bytestream_impl::writeBuffer(out + sizeof(SizeType), input.data(), input.size());
+			}
 		}
 
-		template <typename T, std::enable_if_t<std::is_fundamental_v<T> || std::is_enum_v<T>, int> = 0>
+		template <typename T>
+		void writeBulk(const T* values, size_t count)
+		{
+			if constexpr(std::is_fundamental_v<T> || std::is_enum_v<T>)
+			{
+				if(auto* out = grow(sizeof(T) * count); out != nullptr && count > 0)
+				{
+					bytestream_impl::writeLittleEndian(out, values, count);
+				}
+			}
+			else if constexpr(bytestream_impl::LITTLE_ENDIAN_HOST)
+			{
+				if(auto* out = grow(sizeof(T) * count); out != nullptr && count > 0)
+				{
+					bytestream_impl::writeBuffer(out, values, sizeof(T) * count);
+				}
+			}
+			else
+			{
+				for(size_t i = 0; i < count; ++i)
+				{
+					write(values[i]);
+				}
+			}
+		}
+
+		template <typename T, std::enable_if_t<bytestream_impl::IsBulkCopyable<T>::value, int> = 0>
 		void write(const std::vector<T>& input)
 		{
-			const size_t size0 = outputBytes_.size();
-			const size_t size1 = input.size();
-			const size_t realInputSize = sizeof(T) * input.size();
-			outputBytes_.resize(size0 + sizeof(size_t) + realInputSize);
-			bytestream_impl::writePrimitiveType(&outputBytes_[size0], &size1, sizeof(size_t));
-			if(realInputSize > 0)
+			write(static_cast<bytestream_impl::SizeType>(input.size()));
+			writeBulk(input.data(), input.size());
+		}
+
+		// fixed size, no length prefix
+		template <typename T, size_t N>
+		void write(const std::array<T, N>& input)
+		{
+			if constexpr(bytestream_impl::IsBulkCopyable<T>::value)
 			{
-				bytestream_impl::writeBuffer(&outputBytes_[size0 + sizeof(size_t)], input.data(), realInputSize);
+				writeBulk(input.data(), N);
+			}
+			else
+			{
+				for(const auto& item : input)
+				{
+					write(item);
+				}
 			}
 		}
 
 		template <typename T, std::enable_if_t<bytestream_impl::HasIterator<T>::value, int> = 0>
 		void write(const T& container)
 		{
-			write(container.size());
-			for(auto& item : container)
+			write(static_cast<bytestream_impl::SizeType>(container.size()));
+			for(const auto& item : container)
 			{
 				write(item);
 			}
@@ -213,9 +779,10 @@ namespace {{ns_tpl}}
 		template <typename T, std::enable_if_t<std::is_fundamental_v<T> || std::is_enum_v<T>, int> = 0>
 		void write(T input)
 		{
-			size_t size0 = outputBytes_.size();
-			outputBytes_.resize(size0 + sizeof(T));
-			bytestream_impl::writePrimitiveType(&outputBytes_[size0], &input, sizeof(T));
+			if(auto* out = grow(sizeof(T)))
+			{
+				bytestream_impl::writeLittleEndian(out, &input, 1);
+			}
 		}
 
 		template <typename... Ts>
@@ -262,23 +829,21 @@ namespace {{ns_tpl}}
 
 		void write(const utils::UUID& input)
 		{
-			size_t size0 = outputBytes_.size();
-			outputBytes_.resize(size0 + sizeof(input.data));
-			bytestream_impl::writeBuffer(&outputBytes_[size0], input.data, sizeof(input.data));
+			if(auto* out = grow(sizeof(input.data)))
+			{
+				bytestream_impl::writeBuffer(out, input.data, sizeof(input.data));
+			}
 		}
 
+		// chrono types are written as int64 nanosecond counts
 		void write(const utils::Duration& input)
 		{
-			size_t size0 = outputBytes_.size();
-			outputBytes_.resize(size0 + sizeof(input));
-			bytestream_impl::writeBuffer(&outputBytes_[size0], &input, sizeof(input));
+			write(static_cast<std::int64_t>(input.count()));
 		}
 
 		void write(const utils::TimePoint& input)
 		{
-			size_t size0 = outputBytes_.size();
-			outputBytes_.resize(size0 + sizeof(input));
-			bytestream_impl::writeBuffer(&outputBytes_[size0], &input, sizeof(input));
+			write(input.time_since_epoch());
 		}
 
 		template <typename T, std::enable_if_t<bytestream_impl::HasToBytestream<T>::value, int> = 0>
@@ -288,22 +853,31 @@ namespace {{ns_tpl}}
 		}
 
 		std::vector<std::byte> outputBytes_;
+		// caller buffer of an in place stream, nullptr when writing into outputBytes_
+		std::byte* fixed_ = nullptr;
+		std::size_t fixedCapacity_ = 0;
+		std::size_t fixedSize_ = 0;
+		Status status_ = Status::OK;
 	};
 
 	class IByteStream
 	{
 	public:
 		using Status = bytestream_impl::Status;
+		using Trust = bytestream_impl::Trust;
 
-		IByteStream(const std::byte* buffer, size_t len) : buffer_(buffer), bufferLen_(len)
+		IByteStream(const std::byte* buffer, size_t len, Trust trust = Trust::UNTRUSTED)
+		    : buffer_(buffer), bufferLen_(len), trust_(trust)
 		{
 		}
 
-		IByteStream(const std::vector<std::byte>& bufferVec) : buffer_(bufferVec.data()), bufferLen_(bufferVec.size())
+		IByteStream(const std::vector<std::byte>& bufferVec, Trust trust = Trust::UNTRUSTED)
+		    : buffer_(bufferVec.data()), bufferLen_(bufferVec.size()), trust_(trust)
 		{
 		}
 
-		IByteStream(const std::string_view& str_view) : buffer_(reinterpret_cast<const std::byte*>(str_view.data())), bufferLen_(str_view.size())
+		IByteStream(const std::string_view& str_view, Trust trust = Trust::UNTRUSTED)
+		    : buffer_(reinterpret_cast<const std::byte*>(str_view.data())), bufferLen_(str_view.size()), trust_(trust)
 		{
 		}
 
@@ -328,14 +902,44 @@ namespace {{ns_tpl}}
 		{
 			return readPtr_ == bufferLen_;
 		}
+		/**
+		 * @brief Number of bytes left to read
+		 */
+		std::size_t remaining() const
+		{
+			return bufferLen_ - readPtr_;
+		}
+		/**
+		 * @brief Marks the stream invalid, for decoders that find corrupt data the reads themselves accept
+		 */
+		void invalidate()
+		{
+			status_ = Status::INVALID_READ;
+		}
+
+		/**
+		 * @brief Trust level of the decoded data, see TrustScope to change it for a single read
+		 */
+		Trust getTrust() const
+		{
+			return trust_;
+		}
+		void setTrust(Trust trust)
+		{
+			trust_ = trust;
+		}
+		bool trusted() const
+		{
+			return trust_ == Trust::TRUSTED;
+		}
 
 	private:
 		bool read(std::string& output)
 		{
 			size_t stringSize;
-			if(!read(stringSize))
+			if(!readSize(stringSize))
 				return false;
-			if(readPtr_ + stringSize > bufferLen_)
+			if(stringSize > bufferLen_ - readPtr_)
 				return false;
 			output.resize(stringSize);
 			std::copy_n(buffer_ + readPtr_, stringSize, (std::byte*)output.data());
@@ -351,29 +955,90 @@ namespace {{ns_tpl}}
 		bool read(std::vector<T>& output)
 		{
 			size_t vecSize;
-			if(!read(vecSize))
+			if(!readSize(vecSize))
 				return false;
-			output.resize(vecSize);
-			if constexpr(std::is_fundamental<T>::value || std::is_enum<T>::value)
+			if constexpr(bytestream_impl::IsBulkCopyable<T>::value)
 			{
-				// std::copy_n at once is faster than for-loop on individual item.
-				size_t to_copy = vecSize * sizeof(T);
-				if(readPtr_ + to_copy > bufferLen_)
+				// a single bounds check and copy is faster than for-loop on individual item.
+				if(vecSize > (bufferLen_ - readPtr_) / sizeof(T))
 					return false;
-				if(vecSize > 0)
+				output.resize(vecSize);
+				return readBulk(output.data(), vecSize);
+			}
+			else
+			{
+				output.resize(vecSize);
+				for(size_t i = 0; i < vecSize; ++i)
 				{
-					std::copy_n(buffer_ + readPtr_, to_copy, (std::byte*)output.data());
-					readPtr_ += to_copy;
+					if constexpr(std::is_same<T, bool>::value)
+					{
+						bool value;
+						if(!read(value))
+							return false;
+						output[i] = value;
+					}
+					else if(!read(output[i]))
+						return false;
 				}
 			}
+			return true;
+		}
+
+		template <typename T, size_t N>
+		bool read(std::array<T, N>& output)
+		{
+			if constexpr(bytestream_impl::IsBulkCopyable<T>::value)
+			{
+				return readBulk(output.data(), N);
+			}
 			else
 			{
-				for(size_t i = 0; i < vecSize; ++i)
+				for(auto& item : output)
+				{
+					if(!read(item))
+						return false;
+				}
+				return true;
+			}
+		}
+
+		template <typename T>
+		bool readBulk(T* values, size_t count)
+		{
+			if(count > (bufferLen_ - readPtr_) / sizeof(T))
+				return false;
+			if constexpr(std::is_fundamental_v<T> || std::is_enum_v<T>)
+			{
+				if(count > 0)
+				{
+					bytestream_impl::readLittleEndian(values, buffer_ + readPtr_, count);
+				}
+			}
+			else if constexpr(bytestream_impl::LITTLE_ENDIAN_HOST)
+			{
+				if(count > 0)
 				{
-					if(!read(output[i]))
+					std::memcpy(static_cast<void*>(values), buffer_ + readPtr_, sizeof(T) * count);
+				}
+				if constexpr(bytestream_impl::IsCheckedAlias<T>::value)
+				{
+					// the copy skipped fromByteStream, apply the alias restrictions in one pass
+					if(!trusted())
+					{
+						bytestream_impl::validateRestrictions(static_cast<const T*>(values), count);
+					}
+				}
+			}
+			else
+			{
+				for(size_t i = 0; i < count; ++i)
+				{
+					if(!read(values[i]))
 						return false;
 				}
+				return true;
 			}
+			readPtr_ += sizeof(T) * count;
 			return true;
 		}
 
@@ -382,11 +1047,23 @@ namespace {{ns_tpl}}
 		{
 			if(readPtr_ + sizeof(T) > bufferLen_)
 				return false;
-			std::copy_n(buffer_ + readPtr_, sizeof(T), (std::byte*)&output);
+			bytestream_impl::readLittleEndian(&output, buffer_ + readPtr_, 1);
 			readPtr_ += sizeof(T);
 			return true;
 		}
 
+		/**
+		 * @brief Reads a wire length prefix, fails if it doesn't fit the host size_t
+		 */
+		bool readSize(size_t& output)
+		{
+			bytestream_impl::SizeType size;
+			if(!read(size) || size > std::numeric_limits<size_t>::max())
+				return false;
+			output = static_cast<size_t>(size);
+			return true;
+		}
+
 		template <typename... Ts>
 		bool readTuple(std::tuple<Ts...>&, std::index_sequence<sizeof...(Ts)>)
 		{
@@ -434,7 +1111,7 @@ namespace {{ns_tpl}}
 		bool readContainer(T& output, Inserter inserter)
 		{
 			size_t containerSize;
-			if(!read(containerSize))
+			if(!readSize(containerSize))
 				return false;
 			for(size_t i = 0; i < containerSize; ++i)
 			{
@@ -487,21 +1164,19 @@ namespace {{ns_tpl}}
 
 		bool read(utils::Duration& output)
 		{
-			constexpr auto size = sizeof(output);
-			if(readPtr_ + size > bufferLen_)
+			std::int64_t count;
+			if(!read(count))
 				return false;
-			std::memcpy(&output, buffer_ + readPtr_, size);
-			readPtr_ += size;
+			output = utils::Duration(count);
 			return true;
 		}
 
 		bool read(utils::TimePoint& output)
 		{
-			const auto size = sizeof(output);
-			if(readPtr_ + size > bufferLen_)
+			utils::Duration sinceEpoch;
+			if(!read(sinceEpoch))
 				return false;
-			std::memcpy(&output, buffer_ + readPtr_, size);
-			readPtr_ += size;
+			output = utils::TimePoint(sinceEpoch);
 			return true;
 		}
 
@@ -509,6 +1184,41 @@ namespace {{ns_tpl}}
 		const std::byte* buffer_ = nullptr;
 		size_t readPtr_ = 0;
 		size_t bufferLen_ = 0;
+		Trust trust_ = Trust::UNTRUSTED;
+	};
+
+	/**
+	 * @brief Sets the trust level of a stream for a scope and restores it after, e.g. to read
+	 * one message from a trusted peer out of an untrusted stream. Generated structs use it to
+	 * defer their field checks to a single validateRestrictions pass.
+	 */
+	class TrustScope
+	{
+	public:
+		TrustScope(IByteStream& stream, IByteStream::Trust trust) : stream_(stream), previous_(stream.getTrust())
+		{
+			stream_.setTrust(trust);
+		}
+
+		~TrustScope()
+		{
+			stream_.setTrust(previous_);
+		}
+
+		TrustScope(const TrustScope&) = delete;
+		TrustScope& operator=(const TrustScope&) = delete;
+
+		/**
+		 * @brief Trust level the stream had when the scope started
+		 */
+		IByteStream::Trust previous() const
+		{
+			return previous_;
+		}
+
+	private:
+		IByteStream& stream_;
+		IByteStream::Trust previous_;
 	};
 
 } // namespace {{ns_tpl}}
\ No newline at end of file
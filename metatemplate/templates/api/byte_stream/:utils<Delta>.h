@@ -0,0 +1,228 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "{{path_package}}/byte_stream/ByteStream.h"
+#include "{{path_package}}/utils/EssentiallyEqual.h"
+
+namespace {{ns_tpl}}
+{
+	// Delta encoding of a value against a previous value the reader already holds.
+	// Generated structs provide static encodeDelta/applyDelta writing a bitmap of the
+	// changed fields followed by the delta of each changed field, optionals and lists
+	// recurse into their values, anything else is written in full.
+	namespace delta_impl
+	{
+		template <typename T, typename = void>
+		class HasDelta : public std::false_type
+		{
+		};
+		template <typename T>
+		class HasDelta<T, std::void_t<decltype(&T::encodeDelta), decltype(&T::applyDelta)>> : public std::true_type
+		{
+		};
+
+		/**
+		 * @brief Element comparison for lists, matches the generated operator==
+		 */
+		template <typename T>
+		[[nodiscard]] bool unchanged(const T& prev, const T& cur)
+		{
+			if constexpr(std::is_floating_point_v<T>)
+			{
+				return utils::EssentiallyEqual(prev, cur);
+			}
+			else
+			{
+				return prev == cur;
+			}
+		}
+	} // namespace delta_impl
+
+	template <typename T, typename = void>
+	class DeltaCodec
+	{
+	public:
+		static void encode(const T&, const T& cur, OByteStream& bs)
+		{
+			bs << cur;
+		}
+
+		static void apply(T& value, IByteStream& bs)
+		{
+			bs >> value;
+		}
+	};
+
+	template <typename T>
+	class DeltaCodec<T, std::enable_if_t<delta_impl::HasDelta<T>::value>>
+	{
+	public:
+		static void encode(const T& prev, const T& cur, OByteStream& bs)
+		{
+			T::encodeDelta(prev, cur, bs);
+		}
+
+		static void apply(T& value, IByteStream& bs)
+		{
+			T::applyDelta(value, bs);
+		}
+	};
+
+	/**
+	 * @brief Optionals write the presence, then the delta of the value if the previous
+	 * one was set too, the full value otherwise.
+	 */
+	template <typename T>
+	class DeltaCodec<std::optional<T>>
+	{
+	public:
+		static void encode(const std::optional<T>& prev, const std::optional<T>& cur, OByteStream& bs)
+		{
+			bs << cur.has_value();
+			if(cur && prev)
+			{
+				DeltaCodec<T>::encode(*prev, *cur, bs);
+			}
+			else if(cur)
+			{
+				bs << *cur;
+			}
+		}
+
+		static void apply(std::optional<T>& value, IByteStream& bs)
+		{
+			bool hasValue = false;
+			bs >> hasValue;
+			if(!hasValue)
+			{
+				value = std::nullopt;
+			}
+			else if(value)
+			{
+				DeltaCodec<T>::apply(*value, bs);
+			}
+			else
+			{
+				value.emplace();
+				bs >> *value;
+			}
+		}
+	};
+
+	/**
+	 * @brief Lists write the new size and a bitmap of the changed elements both lists
+	 * hold, then the delta of those elements and the appended elements in full.
+	 */
+	template <typename T, typename Allocator>
+	class DeltaCodec<std::vector<T, Allocator>>
+	{
+	public:
+		static void encode(const std::vector<T, Allocator>& prev, const std::vector<T, Allocator>& cur, OByteStream& bs)
+		{
+			const std::size_t common = std::min(prev.size(), cur.size());
+			std::vector<std::uint8_t> changed((common + 7) / 8, 0);
+			for(std::size_t i = 0; i < common; ++i)
+			{
+				if(!delta_impl::unchanged<T>(prev[i], cur[i]))
+				{
+					changed[i / 8] |= static_cast<std::uint8_t>(1u << (i % 8));
+				}
+			}
+
+			bs << static_cast<bytestream_impl::SizeType>(cur.size());
+			bs.writeBytes(reinterpret_cast<const std::byte*>(changed.data()), changed.size());
+			for(std::size_t i = 0; i < common; ++i)
+			{
+				if((changed[i / 8] >> (i % 8)) & 1u)
+				{
+					DeltaCodec<T>::encode(prev[i], cur[i], bs);
+				}
+			}
+			for(std::size_t i = common; i < cur.size(); ++i)
+			{
+				bs << static_cast<const T&>(cur[i]);
+			}
+		}
+
+		static void apply(std::vector<T, Allocator>& values, IByteStream& bs)
+		{
+			bytestream_impl::SizeType wireSize = 0;
+			bs >> wireSize;
+			const auto size = static_cast<std::size_t>(wireSize);
+			const std::size_t common = std::min(values.size(), size);
+			std::vector<std::uint8_t> changed((common + 7) / 8, 0);
+			for(auto& byte : changed)
+			{
+				bs >> byte;
+			}
+			if(!bs.ok())
+			{
+				return;
+			}
+			// every appended element takes at least a byte (sizeof(T) when bulk copied),
+			// a size the rest of the stream can't hold is corrupt, don't allocate for it
+			constexpr std::size_t minElementSize = bytestream_impl::IsBulkCopyable<T>::value ? sizeof(T) : 1;
+			if(size - common > bs.remaining() / minElementSize)
+			{
+				bs.invalidate();
+				return;
+			}
+
+			values.resize(size);
+			for(std::size_t i = 0; i < size; ++i)
+			{
+				if(i < common && !((changed[i / 8] >> (i % 8)) & 1u))
+				{
+					continue;
+				}
+				if constexpr(std::is_same_v<T, bool>)
+				{
+					// vector<bool> elements are proxies, decode through a value
+					bool value = values[i];
+					bs >> value;
+					values[i] = value;
+				}
+				else if(i < common)
+				{
+					DeltaCodec<T>::apply(values[i], bs);
+				}
+				else
+				{
+					bs >> values[i];
+				}
+			}
+		}
+	};
+
+	/**
+	 * @brief Writes the changes from prev to cur
+	 *
+	 * @param prev: the value the reader holds
+	 * @param cur: the new value
+	 * @param bs: the stream to write to
+	 */
+	template <typename T>
+	void encodeDelta(const T& prev, const T& cur, OByteStream& bs)
+	{
+		DeltaCodec<T>::encode(prev, cur, bs);
+	}
+
+	/**
+	 * @brief Applies changes written by encodeDelta, value must hold the prev value
+	 *
+	 * @param value: the value to update
+	 * @param bs: the stream to read from
+	 */
+	template <typename T>
+	void applyDelta(T& value, IByteStream& bs)
+	{
+		DeltaCodec<T>::apply(value, bs);
+	}
+} // namespace {{ns_tpl}}
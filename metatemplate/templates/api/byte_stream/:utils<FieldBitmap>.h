@@ -0,0 +1,79 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "{{path_package}}/byte_stream/ByteStream.h"
+
+namespace {{ns_tpl}}
+{
+	/**
+	 * @brief Packed bitmap with one bit per struct field, written to the byte stream as
+	 * ceil(N / 8) bytes.
+	 *
+	 * @tparam N: number of fields
+	 */
+	template <std::size_t N>
+	class FieldBitmap
+	{
+	public:
+		static constexpr std::size_t BYTES = (N + 7) / 8;
+
+		/**
+		 * @brief Sets or clears the bit of a field
+		 *
+		 * @param index: the field index
+		 * @param value: the bit value
+		 */
+		void set(std::size_t index, bool value = true) noexcept
+		{
+			const auto mask = static_cast<std::uint8_t>(1u << (index % 8));
+			bytes_[index / 8] = value ? (bytes_[index / 8] | mask) : (bytes_[index / 8] & ~mask);
+		}
+
+		/**
+		 * @brief Checks the bit of a field
+		 *
+		 * @param index: the field index
+		 * @returns bool
+		 */
+		[[nodiscard]] bool test(std::size_t index) const noexcept
+		{
+			return (bytes_[index / 8] >> (index % 8)) & 1u;
+		}
+
+		/**
+		 * @brief True if any bit is set
+		 *
+		 * @returns bool
+		 */
+		[[nodiscard]] bool any() const noexcept
+		{
+			for(const auto byte : bytes_)
+			{
+				if(byte)
+				{
+					return true;
+				}
+			}
+			return false;
+		}
+
+		void toByteStream(OByteStream& bs) const
+		{
+			bs.writeBytes(reinterpret_cast<const std::byte*>(bytes_.data()), BYTES);
+		}
+
+		void fromByteStream(IByteStream& bs)
+		{
+			for(auto& byte : bytes_)
+			{
+				bs >> byte;
+			}
+		}
+
+	private:
+		std::array<std::uint8_t, BYTES> bytes_{};
+	};
+} // namespace {{ns_tpl}}
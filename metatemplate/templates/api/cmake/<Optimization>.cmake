@@ -0,0 +1,120 @@
+# Build options and helpers shared by the generated metatemplate libraries,
+# included by each generated CMakeLists.txt (api, protobuf, protobuf_converters
+# and python_bindings). Expects METATEMPLATE_SRC_ROOT, the src/ directory all
+# generated includes are relative to, to be set by the including file.
+include_guard(GLOBAL)
+
+include(CheckIPOSupported)
+
+option(METATEMPLATE_LTO "Enable link time optimization (IPO) on the generated targets" OFF)
+set(METATEMPLATE_PGO "" CACHE STRING "Profile guided optimization phase: GENERATE, USE or empty to disable")
+set_property(CACHE METATEMPLATE_PGO PROPERTY STRINGS "" GENERATE USE)
+set(METATEMPLATE_PGO_DIR "${CMAKE_BINARY_DIR}/pgo" CACHE PATH "Profile data written by the GENERATE phase, read by the USE phase")
+option(METATEMPLATE_UNITY "Compile the Unity.<index>.cpp bundles instead of the individual sources when rendered (see --unity)" ON)
+option(METATEMPLATE_PCH "Use the Precompiled.h headers when rendered (see --unity)" ON)
+option(METATEMPLATE_BUILD_TESTS "Build the generated unit tests found under test/unit" OFF)
+option(METATEMPLATE_BUILD_BENCHMARKS "Build the benchmarks found under benchmark/" OFF)
+
+if(METATEMPLATE_LTO)
+    check_ipo_supported(RESULT METATEMPLATE_LTO_SUPPORTED OUTPUT lto_error LANGUAGES CXX)
+    if(NOT METATEMPLATE_LTO_SUPPORTED)
+        message(WARNING "METATEMPLATE_LTO is not supported by this toolchain: ${lto_error}")
+    endif()
+endif()
+
+if(METATEMPLATE_PGO AND NOT METATEMPLATE_PGO MATCHES "^(GENERATE|USE)$")
+    message(FATAL_ERROR "METATEMPLATE_PGO must be GENERATE, USE or empty, got: ${METATEMPLATE_PGO}")
+endif()
+
+# metatemplate_sources(<out_var> <dir>)
+#
+# The .cpp files of a generated directory, replaced by the Unity.<index>.cpp
+# bundles of that directory if they were rendered and METATEMPLATE_UNITY is on.
+# The dot keeps the bundles apart from the sources of schema types (UnityConfig.cpp).
+function(metatemplate_sources out_var dir)
+    file(GLOB unity_sources CONFIGURE_DEPENDS "${dir}/Unity.*.cpp")
+    list(FILTER unity_sources INCLUDE REGEX "/Unity\\.[0-9]+\\.cpp$")
+    if(METATEMPLATE_UNITY AND unity_sources)
+        set(${out_var} ${unity_sources} PARENT_SCOPE)
+        return()
+    endif()
+    file(GLOB sources CONFIGURE_DEPENDS "${dir}/*.cpp")
+    if(unity_sources)
+        list(REMOVE_ITEM sources ${unity_sources})
+    endif()
+    set(${out_var} ${sources} PARENT_SCOPE)
+endfunction()
+
+# metatemplate_precompile(<target> <header>)
+#
+# Precompiles header for target if it was rendered and METATEMPLATE_PCH is on.
+function(metatemplate_precompile target header)
+    if(METATEMPLATE_PCH AND EXISTS "${header}")
+        target_precompile_headers(${target} PRIVATE "${header}")
+    endif()
+endfunction()
+
+# metatemplate_optimize(<target> [HOT])
+#
+# Applies the LTO/PGO configuration to target, HOT also compiles the optimized
+# configurations with -O3 (serialization and conversion code).
+function(metatemplate_optimize target)
+    cmake_parse_arguments(ARG "HOT" "" "" ${ARGN})
+    target_compile_features(${target} PUBLIC cxx_std_17)
+
+    if(METATEMPLATE_LTO AND METATEMPLATE_LTO_SUPPORTED)
+        set_property(TARGET ${target} PROPERTY INTERPROCEDURAL_OPTIMIZATION TRUE)
+    endif()
+
+    if(NOT CMAKE_CXX_COMPILER_ID MATCHES "GNU|Clang")
+        return()
+    endif()
+
+    if(ARG_HOT)
+        target_compile_options(${target} PRIVATE $<$<OR:$<CONFIG:Release>,$<CONFIG:RelWithDebInfo>>:-O3>)
+    endif()
+
+    if(METATEMPLATE_PGO STREQUAL "GENERATE")
+        target_compile_options(${target} PRIVATE -fprofile-generate=${METATEMPLATE_PGO_DIR})
+        # anything linking the instrumented objects needs the profiling runtime
+        target_link_options(${target} PUBLIC -fprofile-generate=${METATEMPLATE_PGO_DIR})
+    elseif(METATEMPLATE_PGO STREQUAL "USE")
+        if(CMAKE_CXX_COMPILER_ID STREQUAL "GNU")
+            target_compile_options(${target} PRIVATE -fprofile-use=${METATEMPLATE_PGO_DIR} -fprofile-correction -Wno-missing-profile)
+        else()
+            # clang reads the output of: llvm-profdata merge -o default.profdata *.profraw
+            target_compile_options(${target} PRIVATE -fprofile-use=${METATEMPLATE_PGO_DIR}/default.profdata -Wno-profile-instr-unprofiled)
+        endif()
+    endif()
+endfunction()
+
+# metatemplate_add_checks(<target> <key>)
+#
+# Wires the unit tests (test/unit/<key>, gtest) and benchmarks (benchmark/<key>,
+# google benchmark) next to the src/ root to target when enabled and present.
+function(metatemplate_add_checks target key)
+    get_filename_component(output_root "${METATEMPLATE_SRC_ROOT}/.." ABSOLUTE)
+
+    set(test_dir "${output_root}/test/unit/${key}")
+    if(METATEMPLATE_BUILD_TESTS AND EXISTS "${test_dir}")
+        find_package(GTest REQUIRED)
+        include(GoogleTest)
+        file(GLOB_RECURSE test_sources CONFIGURE_DEPENDS "${test_dir}/*.cpp")
+        if(test_sources)
+            add_executable(${target}_test ${test_sources})
+            target_link_libraries(${target}_test PRIVATE ${target} GTest::gtest_main)
+            gtest_discover_tests(${target}_test)
+        endif()
+    endif()
+
+    set(benchmark_dir "${output_root}/benchmark/${key}")
+    if(METATEMPLATE_BUILD_BENCHMARKS AND EXISTS "${benchmark_dir}")
+        find_package(benchmark REQUIRED)
+        file(GLOB_RECURSE benchmark_sources CONFIGURE_DEPENDS "${benchmark_dir}/*.cpp")
+        if(benchmark_sources)
+            add_executable(${target}_benchmark ${benchmark_sources})
+            target_link_libraries(${target}_benchmark PRIVATE ${target} benchmark::benchmark_main)
+            metatemplate_optimize(${target}_benchmark)
+        endif()
+    endif()
+endfunction()
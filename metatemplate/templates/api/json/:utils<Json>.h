@@ -0,0 +1,884 @@
+#pragma once
+
+// JSON text encoding of the generated types, for debugging and monitoring output.
+// JsonWriter appends into a reusable buffer (std::to_chars for numbers, no iostreams)
+// and JsonReader decodes straight into the api types without building a document tree.
+//
+// Sample Use Case:
+//
+// json::JsonWriter writer;
+// writer.write(circle);
+// send(writer.view());
+// writer.reset(); // keeps the capacity for the next message
+//
+// json::JsonReader reader(text);
+// Circle circle;
+// reader.read(circle);
+// reader.finish(); // throws on trailing characters
+//
+// Structs are objects keyed by the schema field names, unset optionals are left out.
+// Variants are {"<Choice>": value}, polymorphic members {"<Type>": {...}} or null,
+// enums their names, UUIDs and TimePoints (ISO-8601) strings and Durations integer
+// nanoseconds. Non finite floats are written as the strings "NaN", "Infinity" and
+// "-Infinity". Unknown object keys are skipped when reading.
+
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "{{path_package}}/utils/Clock.h"
+#include "{{path_package}}/utils/UUID.h"
+
+#include "{{path_package}}/types/AbstractFactory.h"
+
+namespace {{ns_tpl}}
+{
+	class JsonWriter;
+	class JsonReader;
+
+	namespace json_impl
+	{
+		template <typename T, typename = void>
+		class HasToJson : public std::false_type
+		{
+		};
+		template <typename T>
+		class HasToJson<T, std::void_t<decltype(std::declval<const T&>().toJson(std::declval<JsonWriter&>()))>> : public std::true_type
+		{
+		};
+
+		template <typename T, typename = void>
+		class HasFromJson : public std::false_type
+		{
+		};
+		template <typename T>
+		class HasFromJson<T, std::void_t<decltype(std::declval<T&>().fromJson(std::declval<JsonReader&>()))>> : public std::true_type
+		{
+		};
+
+		template <typename T, typename = void>
+		class HasIterator : public std::false_type
+		{
+		};
+		template <typename T>
+		class HasIterator<T, std::void_t<typename T::iterator>> : public std::true_type
+		{
+		};
+
+		template <typename T, typename = void>
+		class CanPushBack : public std::false_type
+		{
+		};
+		template <typename T>
+		class CanPushBack<T, std::void_t<decltype(std::declval<T&>().push_back(std::declval<typename T::value_type&&>()))>> : public std::true_type
+		{
+		};
+
+		template <typename T, typename = void>
+		class CanInsert : public std::false_type
+		{
+		};
+		template <typename T>
+		class CanInsert<T, std::void_t<decltype(std::declval<T&>().insert(std::declval<typename T::value_type&&>()))>> : public std::true_type
+		{
+		};
+
+		template <typename T>
+		class IsOptional : public std::false_type
+		{
+		};
+		template <typename T>
+		class IsOptional<std::optional<T>> : public std::true_type
+		{
+		};
+
+		template <typename T>
+		class IsSharedPtr : public std::false_type
+		{
+		};
+		template <typename T>
+		class IsSharedPtr<std::shared_ptr<T>> : public std::true_type
+		{
+		};
+
+		template <typename T>
+		class IsArray : public std::false_type
+		{
+		};
+		template <typename T, std::size_t N>
+		class IsArray<std::array<T, N>> : public std::true_type
+		{
+		};
+
+		/**
+		 * @brief Nesting limit of the reader, bounds its recursion on hostile input
+		 */
+		inline constexpr std::size_t MAX_DEPTH = 256;
+
+		/**
+		 * @brief Characters a JSON string can't hold unescaped
+		 */
+		inline constexpr bool needsEscape(char c) noexcept
+		{
+			return static_cast<unsigned char>(c) < 0x20 || c == '"' || c == '\\';
+		}
+
+		inline constexpr bool isWhitespace(char c) noexcept
+		{
+			return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+		}
+	} // namespace json_impl
+
+	class JsonWriter
+	{
+	public:
+		JsonWriter(std::size_t capacity = 0)
+		{
+			if(capacity > 0)
+			{
+				buffer_.reserve(capacity);
+			}
+		}
+
+		/**
+		 * @brief Drops the written text, keeps the capacity for the next message
+		 */
+		void reset() noexcept
+		{
+			buffer_.clear();
+		}
+
+		/**
+		 * @brief The text written so far, valid until the next write or reset
+		 */
+		[[nodiscard]] std::string_view view() const noexcept
+		{
+			return buffer_;
+		}
+
+		/**
+		 * @brief Moves the written text out of the writer, leaving it empty
+		 */
+		[[nodiscard]] std::string release() noexcept
+		{
+			return std::move(buffer_);
+		}
+
+		[[nodiscard]] std::size_t size() const noexcept
+		{
+			return buffer_.size();
+		}
+
+		void beginObject()
+		{
+			separate();
+			buffer_.push_back('{');
+		}
+
+		void endObject()
+		{
+			buffer_.push_back('}');
+		}
+
+		void beginArray()
+		{
+			separate();
+			buffer_.push_back('[');
+		}
+
+		void endArray()
+		{
+			buffer_.push_back(']');
+		}
+
+		/**
+		 * @brief Writes an object key, the value is the next write
+		 *
+		 * @param name: the key, written as is (the generated field names need no escaping)
+		 */
+		void key(std::string_view name)
+		{
+			separate();
+			buffer_.push_back('"');
+			buffer_.append(name);
+			buffer_.append("\":", 2);
+		}
+
+		void writeNull()
+		{
+			separate();
+			buffer_.append("null", 4);
+		}
+
+		/**
+		 * @brief Writes a value, comma separated from the previous value at the same level
+		 */
+		template <typename T>
+		void write(const T& value)
+		{
+			if constexpr(json_impl::HasToJson<T>::value)
+			{
+				value.toJson(*this);
+			}
+			else if constexpr(std::is_same_v<T, bool>)
+			{
+				separate();
+				value ? buffer_.append("true", 4) : buffer_.append("false", 5);
+			}
+			else if constexpr(std::is_enum_v<T>)
+			{
+				// the generated enums provide toJson next to their declaration
+				toJson(*this, value);
+			}
+			else if constexpr(std::is_integral_v<T> || std::is_floating_point_v<T>)
+			{
+				separate();
+				writeNumber(value);
+			}
+			else if constexpr(std::is_convertible_v<const T&, std::string_view>)
+			{
+				separate();
+				writeString(value);
+			}
+			else if constexpr(std::is_same_v<T, utils::UUID>)
+			{
+				separate();
+				buffer_.push_back('"');
+				char chars[utils::UUID_CHARS];
+				buffer_.append(chars, utils::UUIDtoChars(value, chars));
+				buffer_.push_back('"');
+			}
+			else if constexpr(std::is_same_v<T, utils::Duration>)
+			{
+				write(static_cast<std::int64_t>(value.count()));
+			}
+			else if constexpr(std::is_same_v<T, utils::TimePoint>)
+			{
+				separate();
+				buffer_.push_back('"');
+				char chars[utils::TIME_POINT_CHARS];
+				buffer_.append(chars, utils::toChars(value, chars));
+				buffer_.push_back('"');
+			}
+			else if constexpr(json_impl::IsOptional<T>::value)
+			{
+				value ? write(*value) : writeNull();
+			}
+			else if constexpr(json_impl::IsSharedPtr<T>::value)
+			{
+				types::AbstractFactory<typename T::element_type>::type::to_json(value, *this);
+			}
+			else if constexpr(json_impl::HasIterator<T>::value)
+			{
+				beginArray();
+				for(const auto& item : value)
+				{
+					write(item);
+				}
+				endArray();
+			}
+			else
+			{
+				static_assert(sizeof(T) == 0, "JsonWriter has no encoding for T");
+			}
+		}
+
+	private:
+		/**
+		 * @brief Adds the ',' between values, not after an opening bracket or a key
+		 */
+		void separate()
+		{
+			if(!buffer_.empty())
+			{
+				const char last = buffer_.back();
+				if(last != '{' && last != '[' && last != ':')
+				{
+					buffer_.push_back(',');
+				}
+			}
+		}
+
+		template <typename T>
+		void writeNumber(T value)
+		{
+			if constexpr(std::is_floating_point_v<T>)
+			{
+				if(!std::isfinite(value))
+				{
+					writeString(std::isnan(value) ? "NaN" : value > 0 ? "Infinity" : "-Infinity");
+					return;
+				}
+			}
+			// enough for any 64 bit integer and the shortest round trip double
+			char chars[32];
+			const auto result = std::to_chars(chars, chars + sizeof(chars), value);
+			buffer_.append(chars, result.ptr);
+		}
+
+		void writeString(std::string_view value)
+		{
+			static constexpr char HEX[] = "0123456789abcdef";
+			buffer_.push_back('"');
+			std::size_t begin = 0;
+			for(std::size_t i = 0; i < value.size(); ++i)
+			{
+				const char c = value[i];
+				if(!json_impl::needsEscape(c))
+				{
+					continue;
+				}
+				buffer_.append(value.data() + begin, i - begin);
+				begin = i + 1;
+				switch(c)
+				{
+					case '"':
+						buffer_.append("\\\"", 2);
+						break;
+					case '\\':
+						buffer_.append("\\\\", 2);
+						break;
+					case '\n':
+						buffer_.append("\\n", 2);
+						break;
+					case '\r':
+						buffer_.append("\\r", 2);
+						break;
+					case '\t':
+						buffer_.append("\\t", 2);
+						break;
+					case '\b':
+						buffer_.append("\\b", 2);
+						break;
+					case '\f':
+						buffer_.append("\\f", 2);
+						break;
+					default:
+					{
+						const char escaped[] = { '\\', 'u', '0', '0', HEX[(c >> 4) & 0xf], HEX[c & 0xf] };
+						buffer_.append(escaped, sizeof(escaped));
+					}
+				}
+			}
+			buffer_.append(value.data() + begin, value.size() - begin);
+			buffer_.push_back('"');
+		}
+
+		std::string buffer_;
+	};
+
+	class JsonReader
+	{
+	public:
+		explicit JsonReader(std::string_view text) noexcept : text_(text)
+		{
+		}
+
+		/**
+		 * @brief Reads a value
+		 *
+		 * @throws std::runtime_error on malformed JSON or a value that doesn't fit T
+		 */
+		template <typename T>
+		void read(T& value)
+		{
+			if constexpr(json_impl::HasFromJson<T>::value)
+			{
+				value.fromJson(*this);
+			}
+			else if constexpr(std::is_same_v<T, bool>)
+			{
+				skipWhitespace();
+				if(consumeLiteral("true"))
+				{
+					value = true;
+				}
+				else if(consumeLiteral("false"))
+				{
+					value = false;
+				}
+				else
+				{
+					fail("expected true or false");
+				}
+			}
+			else if constexpr(std::is_enum_v<T>)
+			{
+				// the generated enums provide fromJson next to their declaration
+				fromJson(*this, value);
+			}
+			else if constexpr(std::is_integral_v<T> || std::is_floating_point_v<T>)
+			{
+				readNumber(value);
+			}
+			else if constexpr(std::is_same_v<T, std::string>)
+			{
+				readString(value);
+			}
+			else if constexpr(std::is_same_v<T, utils::UUID>)
+			{
+				const auto chars = readStringView();
+				if(utils::UUIDfromChars(chars.data(), chars.data() + chars.size(), value) != chars.data() + chars.size())
+				{
+					fail("expected a UUID");
+				}
+			}
+			else if constexpr(std::is_same_v<T, utils::Duration>)
+			{
+				std::int64_t count;
+				readNumber(count);
+				value = utils::Duration(count);
+			}
+			else if constexpr(std::is_same_v<T, utils::TimePoint>)
+			{
+				const auto chars = readStringView();
+				if(utils::fromChars(chars.data(), chars.data() + chars.size(), value) != chars.data() + chars.size())
+				{
+					fail("expected an ISO-8601 time point");
+				}
+			}
+			else if constexpr(json_impl::IsOptional<T>::value)
+			{
+				if(readNull())
+				{
+					value.reset();
+				}
+				else
+				{
+					read(value.emplace());
+				}
+			}
+			else if constexpr(json_impl::IsSharedPtr<T>::value)
+			{
+				value = types::AbstractFactory<typename T::element_type>::type::from_json(*this);
+			}
+			else if constexpr(json_impl::IsArray<T>::value)
+			{
+				std::size_t count = 0;
+				readArray([&] {
+					if(count == value.size())
+					{
+						fail("too many array elements");
+					}
+					read(value[count++]);
+				});
+				if(count != value.size())
+				{
+					fail("too few array elements");
+				}
+			}
+			else if constexpr(json_impl::CanPushBack<T>::value || json_impl::CanInsert<T>::value)
+			{
+				value.clear();
+				readArray([&] {
+					typename T::value_type item{};
+					read(item);
+					if constexpr(json_impl::CanPushBack<T>::value)
+					{
+						value.push_back(std::move(item));
+					}
+					else
+					{
+						value.insert(std::move(item));
+					}
+				});
+			}
+			else
+			{
+				static_assert(sizeof(T) == 0, "JsonReader has no decoding for T");
+			}
+		}
+
+		/**
+		 * @brief Reads an object, onKey(key) must read or skip the value of each key
+		 *
+		 * @note the key view is only valid until the next string is read
+		 */
+		template <typename OnKey>
+		void readObject(OnKey&& onKey)
+		{
+			enter('{');
+			skipWhitespace();
+			if(consume('}'))
+			{
+				--depth_;
+				return;
+			}
+			do
+			{
+				skipWhitespace();
+				const auto key = readStringView();
+				skipWhitespace();
+				expect(':');
+				onKey(key);
+				skipWhitespace();
+			} while(consume(','));
+			expect('}');
+			--depth_;
+		}
+
+		/**
+		 * @brief Reads an array, onElement() must read or skip each element
+		 */
+		template <typename OnElement>
+		void readArray(OnElement&& onElement)
+		{
+			enter('[');
+			skipWhitespace();
+			if(consume(']'))
+			{
+				--depth_;
+				return;
+			}
+			do
+			{
+				onElement();
+				skipWhitespace();
+			} while(consume(','));
+			expect(']');
+			--depth_;
+		}
+
+		/**
+		 * @brief The first character of the next value, '\0' at the end of the text
+		 */
+		[[nodiscard]] char peek() noexcept
+		{
+			skipWhitespace();
+			return pos_ < text_.size() ? text_[pos_] : '\0';
+		}
+
+		/**
+		 * @brief Consumes a null
+		 *
+		 * @return true if the next value was null
+		 */
+		bool readNull()
+		{
+			skipWhitespace();
+			return consumeLiteral("null");
+		}
+
+		/**
+		 * @brief Reads a string without copying it when it has no escapes
+		 *
+		 * @return the unescaped string, valid until the next string is read
+		 */
+		std::string_view readStringView()
+		{
+			skipWhitespace();
+			expect('"');
+			const auto begin = pos_;
+			while(pos_ < text_.size() && text_[pos_] != '"' && text_[pos_] != '\\')
+			{
+				if(static_cast<unsigned char>(text_[pos_]) < 0x20)
+				{
+					fail("unescaped control character in string");
+				}
+				++pos_;
+			}
+			if(pos_ < text_.size() && text_[pos_] == '"')
+			{
+				return text_.substr(begin, pos_++ - begin);
+			}
+			scratch_.assign(text_.data() + begin, pos_ - begin);
+			readEscaped(scratch_);
+			return scratch_;
+		}
+
+		/**
+		 * @brief Skips a value of any type, e.g. of an unknown key
+		 */
+		void skipValue()
+		{
+			skipWhitespace();
+			if(pos_ == text_.size())
+			{
+				fail("expected a value");
+			}
+			switch(text_[pos_])
+			{
+				case '{':
+					readObject([this](std::string_view) { skipValue(); });
+					break;
+				case '[':
+					readArray([this] { skipValue(); });
+					break;
+				case '"':
+					(void)readStringView();
+					break;
+				default:
+				{
+					// numbers and literals, read until a delimiter
+					const auto begin = pos_;
+					while(pos_ < text_.size() && !json_impl::isWhitespace(text_[pos_]) && text_[pos_] != ','
+						&& text_[pos_] != '}' && text_[pos_] != ']')
+					{
+						++pos_;
+					}
+					if(pos_ == begin)
+					{
+						fail("expected a value");
+					}
+				}
+			}
+		}
+
+		/**
+		 * @brief Checks only whitespace follows the last value
+		 *
+		 * @throws std::runtime_error on trailing characters
+		 */
+		void finish()
+		{
+			skipWhitespace();
+			if(pos_ != text_.size())
+			{
+				fail("unexpected trailing characters");
+			}
+		}
+
+		[[nodiscard]] std::size_t offset() const noexcept
+		{
+			return pos_;
+		}
+
+		[[noreturn]] void fail(const char* what) const
+		{
+			throw std::runtime_error(std::string("json: ") + what + " at offset " + std::to_string(pos_));
+		}
+
+	private:
+		void skipWhitespace() noexcept
+		{
+			while(pos_ < text_.size() && json_impl::isWhitespace(text_[pos_]))
+			{
+				++pos_;
+			}
+		}
+
+		bool consume(char c) noexcept
+		{
+			if(pos_ < text_.size() && text_[pos_] == c)
+			{
+				++pos_;
+				return true;
+			}
+			return false;
+		}
+
+		void expect(char c)
+		{
+			if(!consume(c))
+			{
+				const char what[] = { 'e', 'x', 'p', 'e', 'c', 't', 'e', 'd', ' ', '\'', c, '\'', '\0' };
+				fail(what);
+			}
+		}
+
+		bool consumeLiteral(std::string_view literal) noexcept
+		{
+			if(text_.compare(pos_, literal.size(), literal) == 0)
+			{
+				pos_ += literal.size();
+				return true;
+			}
+			return false;
+		}
+
+		void enter(char open)
+		{
+			skipWhitespace();
+			expect(open);
+			if(++depth_ > json_impl::MAX_DEPTH)
+			{
+				fail("nesting too deep");
+			}
+		}
+
+		template <typename T>
+		void readNumber(T& value)
+		{
+			skipWhitespace();
+			if constexpr(std::is_floating_point_v<T>)
+			{
+				if(pos_ < text_.size() && text_[pos_] == '"')
+				{
+					const auto special = readStringView();
+					if(special == "NaN")
+						value = std::numeric_limits<T>::quiet_NaN();
+					else if(special == "Infinity")
+						value = std::numeric_limits<T>::infinity();
+					else if(special == "-Infinity")
+						value = -std::numeric_limits<T>::infinity();
+					else
+						fail("expected a number");
+					return;
+				}
+			}
+			const auto begin = text_.data() + pos_;
+			const auto result = std::from_chars(begin, text_.data() + text_.size(), value);
+			if(result.ec != std::errc{} || result.ptr == begin)
+			{
+				fail(result.ec == std::errc::result_out_of_range ? "number out of range" : "expected a number");
+			}
+			pos_ += static_cast<std::size_t>(result.ptr - begin);
+		}
+
+		void readString(std::string& value)
+		{
+			const auto chars = readStringView();
+			value.assign(chars.data(), chars.size());
+		}
+
+		/**
+		 * @brief Continues a string from its first '\\', appending to output
+		 */
+		void readEscaped(std::string& output)
+		{
+			while(pos_ < text_.size())
+			{
+				const char c = text_[pos_++];
+				if(c == '"')
+				{
+					return;
+				}
+				if(static_cast<unsigned char>(c) < 0x20)
+				{
+					fail("unescaped control character in string");
+				}
+				if(c != '\\')
+				{
+					output.push_back(c);
+					continue;
+				}
+				if(pos_ == text_.size())
+				{
+					break;
+				}
+				switch(text_[pos_++])
+				{
+					case '"':
+						output.push_back('"');
+						break;
+					case '\\':
+						output.push_back('\\');
+						break;
+					case '/':
+						output.push_back('/');
+						break;
+					case 'b':
+						output.push_back('\b');
+						break;
+					case 'f':
+						output.push_back('\f');
+						break;
+					case 'n':
+						output.push_back('\n');
+						break;
+					case 'r':
+						output.push_back('\r');
+						break;
+					case 't':
+						output.push_back('\t');
+						break;
+					case 'u':
+						appendUtf8(output, readCodePoint());
+						break;
+					default:
+						fail("invalid escape");
+				}
+			}
+			fail("unterminated string");
+		}
+
+		std::uint32_t readHex4()
+		{
+			if(text_.size() - pos_ < 4)
+			{
+				fail("truncated \\u escape");
+			}
+			std::uint32_t value = 0;
+			for(int i = 0; i < 4; ++i)
+			{
+				const char c = text_[pos_++];
+				value <<= 4;
+				if(c >= '0' && c <= '9')
+					value |= static_cast<std::uint32_t>(c - '0');
+				else if(c >= 'a' && c <= 'f')
+					value |= static_cast<std::uint32_t>(c - 'a' + 10);
+				else if(c >= 'A' && c <= 'F')
+					value |= static_cast<std::uint32_t>(c - 'A' + 10);
+				else
+					fail("invalid \\u escape");
+			}
+			return value;
+		}
+
+		/**
+		 * @brief Reads the hex digits of a \\u escape, joining UTF-16 surrogate pairs
+		 */
+		std::uint32_t readCodePoint()
+		{
+			const auto high = readHex4();
+			if(high < 0xd800 || high > 0xdfff)
+			{
+				return high;
+			}
+			if(high > 0xdbff || !consumeLiteral("\\u"))
+			{
+				fail("unpaired surrogate");
+			}
+			const auto low = readHex4();
+			if(low < 0xdc00 || low > 0xdfff)
+			{
+				fail("unpaired surrogate");
+			}
+			return 0x10000 + ((high - 0xd800) << 10) + (low - 0xdc00);
+		}
+
+		static void appendUtf8(std::string& output, std::uint32_t codePoint)
+		{
+			if(codePoint < 0x80)
+			{
+				output.push_back(static_cast<char>(codePoint));
+			}
+			else if(codePoint < 0x800)
+			{
+				output.push_back(static_cast<char>(0xc0 | (codePoint >> 6)));
+				output.push_back(static_cast<char>(0x80 | (codePoint & 0x3f)));
+			}
+			else if(codePoint < 0x10000)
+			{
+				output.push_back(static_cast<char>(0xe0 | (codePoint >> 12)));
+				output.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3f)));
+				output.push_back(static_cast<char>(0x80 | (codePoint & 0x3f)));
+			}
+			else
+			{
+				output.push_back(static_cast<char>(0xf0 | (codePoint >> 18)));
+				output.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3f)));
+				output.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3f)));
+				output.push_back(static_cast<char>(0x80 | (codePoint & 0x3f)));
+			}
+		}
+
+		std::string_view text_;
+		std::size_t pos_ = 0;
+		std::size_t depth_ = 0;
+		std::string scratch_;
+	};
+
+} // namespace {{ns_tpl}}
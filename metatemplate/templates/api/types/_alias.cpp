@@ -1,35 +1,18 @@
-#include <stdexcept>
-
-{%- if false and type_info is alias.has_restriction('pattern') %}
-#include <boost/regex.hpp>
-{%- endif %}
+#include <ostream>
+#include <utility>
 
 {%- if type_info is alias.is_float %}
 #include {{"utils/EssentiallyEqual.h" | util_ns.incl}}
 {%- endif %}
 
 
+#include {{"utils/Hash.h" | util_ns.incl}}
 #include {{"utils/Stream.h" | util_ns.incl}}
 #include {{"byte_stream/ByteStream.h" | util_ns.incl}}
+#include {{"json/Json.h" | util_ns.incl}}
 
 #include "{{type_name}}.h"
 
-{%- set restriction_map = {
-	'min_inclusive': '{var} < {restrict}',
-	'min_exclusive': '{var} <= {restrict}',
-	'max_inclusive': '{var} > {restrict}',
-	'max_exclusive': '{var} >= {restrict}',
-	'length': '{var}.length() != {restrict}',
-	'min_length': '{var}.length() < {restrict}',
-	'max_length': '{var}.length() > {restrict}',
-    
-} %}
-{# TODO: enable patterm matching...copy into restriction map above
-had boost build error at some point - also need to remove "false and"
-from the include condition above for boost/regex.hpp
-'pattern': '!boost::regex_search({var}, boost::regex({restrict}))',
-#}
-
 namespace {{ns_tpl}}
 {
 
@@ -63,22 +46,26 @@ namespace {{ns_tpl}}
 	{
 		{{type_info|alias.primitive}} value{};
 		bs >> value;
-		setValue(value);
+		if (bs.trusted())
+		{
+			value_ = std::move(value);
+		}
+		else
+		{
+			setValue(value);
+		}
 	}
 
-	{{type_name}}::const_ref_type {{type_name}}::checkValue({{type_name}}::const_ref_type val)
+	void {{type_name}}::toJson(json::JsonWriter& writer) const
 	{
-		{%- for field_name, f_string in restriction_map.items() %}
-		{%-   if type_info is alias.has_restriction(field_name) %}
-		if ({{f_string.format(var="val",restrict=field_name.upper())}}) {
-			throw std::invalid_argument(
-				"{{type_name}}::value failed {{field_name}} test"
-			);
-		}
-		{%-   endif %}
-		{%- endfor %}
+		writer.write(value_);
+	}
 
-		return val;
+	void {{type_name}}::fromJson(json::JsonReader& reader)
+	{
+		{{type_info|alias.primitive}} value{};
+		reader.read(value);
+		setValue(value);
 	}
 
     /**
@@ -97,6 +84,14 @@ namespace {{ns_tpl}}
 		return os;
 	}
 
+    /**
+	 * @brief hash of the wrapped value, consistent with operator==
+	 */
+	std::size_t {{type_name}}::hash() const noexcept
+	{
+		return utils::hashValue(value_);
+	}
+
     /**
 	 * @brief equality operator for {{type_name}}
 	 *
@@ -1,10 +1,22 @@
 #pragma once
 
-#include <iostream>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <stdexcept>
+#include <utility>
 {%- if type_info is alias.is_string %}
+#include <string>
 #include <string_view>
 {%- endif %}
 
+{%- set pattern_dfa = type_info|alias.pattern_dfa %}
+{%- if pattern_dfa %}
+
+#include {{"utils/Pattern.h" | util_ns.incl}}
+{%- endif %}
+
 {%- for include in type_info|alias.includes %}
 #include {{include|incl.quote_fix(path_package)}}
 {%- endfor %}
@@ -14,6 +26,11 @@ namespace {{ns_package}}::byte_stream {
     class IByteStream;
 }
 
+namespace {{ns_package}}::json {
+    class JsonWriter;
+    class JsonReader;
+}
+
 namespace {{ns_tpl}}
 {
 
@@ -28,24 +45,41 @@ namespace {{ns_tpl}}
 		using ref_type = alias_type&;
 		using const_ref_type = const alias_type&;
 
+		{%- if type_info is alias.is_bulk_copyable %}
+
+		/**
+		 * @brief alias_type is fixed size, lists of {{type_name}} are written/read with a single copy
+		 */
+		static constexpr bool BULK_COPYABLE = true;
+		{%- endif %}
+
 		
-		{%- set const_type = "const" if type_info is alias.is_string else "constexpr" %}
+		{%- set const_type = "constexpr" if type_info is alias.is_literal else "inline const" %}
+		{%- set restriction_map = {
+			'min_inclusive': '{var} < {restrict}',
+			'min_exclusive': '{var} <= {restrict}',
+			'max_inclusive': '{var} > {restrict}',
+			'max_exclusive': '{var} >= {restrict}',
+			'length': '{var}.length() != {restrict}',
+			'min_length': '{var}.length() < {restrict}',
+			'max_length': '{var}.length() > {restrict}',
+		} %}
 
         {%- set field_name = "min_inclusive" %}
         {%- if type_info is alias.has_restriction(field_name) %}
-        static inline const alias_type {{field_name.upper()}} { {{type_info|alias.restriction(field_name)}} };
+        static {{const_type}} alias_type {{field_name.upper()}} { {{type_info|alias.restriction(field_name)}} };
 		{%- endif %}
         {%- set field_name = "min_exclusive" %}
         {%- if type_info is alias.has_restriction(field_name) %}
-        static inline const alias_type {{field_name.upper()}} { {{type_info|alias.restriction(field_name)}} };
+        static {{const_type}} alias_type {{field_name.upper()}} { {{type_info|alias.restriction(field_name)}} };
 		{%- endif %}
         {%- set field_name = "max_inclusive" %}
         {%- if type_info is alias.has_restriction(field_name) %}
-        static inline const alias_type {{field_name.upper()}} { {{type_info|alias.restriction(field_name)}} };
+        static {{const_type}} alias_type {{field_name.upper()}} { {{type_info|alias.restriction(field_name)}} };
 		{%- endif %}
         {%- set field_name = "max_exclusive" %}
         {%- if type_info is alias.has_restriction(field_name) %}
-        static inline const alias_type {{field_name.upper()}} { {{type_info|alias.restriction(field_name)}} };
+        static {{const_type}} alias_type {{field_name.upper()}} { {{type_info|alias.restriction(field_name)}} };
 		{%- endif %}
         {%- set field_name = "length" %}
         {%- if type_info is alias.has_restriction(field_name) %}
@@ -63,7 +97,7 @@ namespace {{ns_tpl}}
         {%- if type_info is alias.is_string -%}
         {%-   set field_name = "pattern" %}
         {%-   if type_info is alias.has_restriction(field_name) %}
-        static inline const alias_type {{field_name.upper()}} { {{type_info|alias.restriction(field_name)|tojson}} };
+        static constexpr std::string_view {{field_name.upper()}} { {{type_info|alias.restriction(field_name)|tojson}} };
 		{%-   endif %}
 		{%- endif %}
         
@@ -94,10 +128,9 @@ namespace {{ns_tpl}}
 		 * @brief Value checking Constructor
          * @param value
 		 */
-		{{type_name}}(const_ref_type value)
+		{{"constexpr " if type_info is alias.is_literal else ""}}{{type_name}}(const_ref_type value)
 		: value_(checkValue(value))
 		{
-			setValue(value);
 		}
 
         /**
@@ -134,12 +167,82 @@ namespace {{ns_tpl}}
         void toByteStream(byte_stream::OByteStream& bs) const;
 
         /*
-         * @brief Reads the alias from a byte stream
+         * @brief Reads the alias from a byte stream, the restrictions are skipped when the
+         * stream is trusted
          *
          * @param bs The bytestream.
          */
         void fromByteStream(byte_stream::IByteStream& bs);
 
+        /**
+         * @brief Applies the restrictions to the held value, for values read without checks
+         *
+         * @throws std::invalid_argument if constraint fails
+         */
+        void validate() const
+        {
+            checkValue(value_);
+        }
+
+        /**
+         * @brief Checks the restrictions without throwing
+         *
+         * @param val Value to check
+         * @return true if val meets every restriction
+         */
+		static {{"constexpr " if type_info is alias.is_literal else ""}}bool isValid(const_ref_type val) noexcept
+		{
+			{%- set ns = namespace(checks=[]) %}
+			{%- for field_name, f_string in restriction_map.items() %}
+			{%-   if type_info is alias.has_restriction(field_name) %}
+			{%-     set ns.checks = ns.checks + ["!(" ~ f_string.format(var="val",restrict=field_name.upper()) ~ ")"] %}
+			{%-   endif %}
+			{%- endfor %}
+			{%- if pattern_dfa %}
+			{%-   set ns.checks = ns.checks + ["PATTERN_DFA.matches(val)"] %}
+			{%- endif %}
+			{%- if ns.checks %}
+			// & rather than && so the checks of a list of values vectorize, see allValid
+			return {{ns.checks|join(" & ")}};
+			{%- else %}
+			static_cast<void>(val);
+			return true;
+			{%- endif %}
+		}
+
+        /**
+         * @brief Checks the restrictions of count values in one branch free pass, the batched
+         * check of lists read from an untrusted byte stream
+         *
+         * @param values First value to check
+         * @param count Number of values
+         * @return true if every value meets the restrictions
+         */
+		static bool allValid(const {{type_name}}* values, std::size_t count) noexcept
+		{
+			// an integer accumulator, compilers won't vectorize a bool reduction
+			std::size_t valid = 1;
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				valid &= static_cast<std::size_t>(isValid(values[i].value_));
+			}
+			return valid != 0;
+		}
+
+        /*
+         * @brief Writes the alias as its underlying JSON value
+         *
+         * @param writer The JSON writer.
+         */
+        void toJson(json::JsonWriter& writer) const;
+
+        /*
+         * @brief Reads the alias from its underlying JSON value, applying the restrictions
+         *
+         * @param reader The JSON reader.
+         */
+        void fromJson(json::JsonReader& reader);
+
         /**
          * @brief Copy assignment operator
          *
@@ -154,15 +257,75 @@ namespace {{ns_tpl}}
          */
         {{type_name}}& operator=({{type_name}}&& other) noexcept = default;
 
+        /**
+         * @brief Hash of the value, consistent with operator==
+         *
+         * @return std::size_t
+         */
+        [[nodiscard]] std::size_t hash() const noexcept;
+
+        /**
+         * @brief Abseil hash support, see https://abseil.io/docs/cpp/guides/hash
+         */
+        template <typename H>
+        friend H AbslHashValue(H h, const {{type_name}}& value)
+        {
+            return H::combine(std::move(h), value.hash());
+        }
+
     private:
+		{%- if pattern_dfa %}
+
+		/**
+		 * @brief PATTERN compiled by the generator, see utils/Pattern.h
+		 */
+		static constexpr utils::PatternDfa<{{pattern_dfa.state_type}}, {{pattern_dfa.class_count}}, {{pattern_dfa.state_count}}> PATTERN_DFA{
+			{
+			{%- for row in pattern_dfa.classes|batch(32) %}
+				{{row|join(", ")}}{{"," if not loop.last}}
+			{%- endfor %}
+			},
+			{
+			{%- for row in pattern_dfa.transitions|batch(pattern_dfa.class_count) %}
+				{{row|join(", ")}}{{"," if not loop.last}}
+			{%- endfor %}
+			},
+			{ {{pattern_dfa.accepting|map("lower")|join(", ")}} }};
+		{%- endif %}
+
+
+
         /*
-         * @brief Constraints check with constexpr support
+         * @brief Constraints check, inline so the bounds fold into the callers and
+         * constexpr where the alias_type allows
          *
          * @param val Value to check bounds
 		 * @return val if no assertion fails
 		 * @throws std::invalid_argument if constraint fails
          */
-		static const_ref_type checkValue(const_ref_type val);
+		static {{"constexpr " if type_info is alias.is_literal else ""}}const_ref_type checkValue(const_ref_type val)
+		{
+			{%- for field_name, f_string in restriction_map.items() %}
+			{%-   if type_info is alias.has_restriction(field_name) %}
+			if ({{f_string.format(var="val",restrict=field_name.upper())}})
+			{
+				throw std::invalid_argument(
+					"{{type_name}}::value failed {{field_name}} test"
+				);
+			}
+			{%-   endif %}
+			{%- endfor %}
+			{%- if pattern_dfa %}
+			if (!PATTERN_DFA.matches(val))
+			{
+				throw std::invalid_argument(
+					"{{type_name}}::value failed pattern test"
+				);
+			}
+			{%- endif %}
+
+			return val;
+		}
 
 		alias_type value_{};
 	};
@@ -228,4 +391,16 @@ namespace {{ns_tpl}}
 	 * @returns bool
 	 */
 	bool operator>=(const {{type_name}}& lhs, const {{type_name}}& rhs);
-} // namespace {{ns_tpl}}
\ No newline at end of file
+} // namespace {{ns_tpl}}
+
+namespace std
+{
+    template <>
+    struct hash<{{ns_tpl}}::{{type_name}}>
+    {
+        std::size_t operator()(const {{ns_tpl}}::{{type_name}}& value) const noexcept
+        {
+            return value.hash();
+        }
+    };
+} // namespace std
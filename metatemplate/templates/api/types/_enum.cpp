@@ -1,5 +1,9 @@
 #include <cstdint>
-#include <iostream>
+#include <ostream>
+#include <string_view>
+#include <type_traits>
+
+#include {{"json/Json.h" | util_ns.incl}}
 
 #include "{{type_name}}.h"
 
@@ -7,22 +11,35 @@ namespace {{ns_tpl}}
 {
     std::ostream& operator<<(std::ostream& os, {{type_name}} value)
     {
-		switch(value)
+		const auto name = toStringView(value);
+		return os << (name.empty() ? std::string_view("UNKNOWN") : name);
+    }
+
+    void toJson(json::JsonWriter& writer, {{type_name}} value)
+    {
+		const auto name = toStringView(value);
+		if (!name.empty())
 		{
-            {%- for attr in type_info.attrs %}
-            case {{type_name}}::{{attr|enum.name}}:
-			{
-				os << "{{attr|enum.name}}";
-				break;
-			}
-            {%- endfor %}
-			default:
-			{
-				os << "UNKNOWN";
-				break;
-			}
+			writer.write(name);
+			return;
 		}
+		writer.write(static_cast<std::underlying_type_t<{{type_name}}>>(value));
+    }
 
-		return os;
+    void fromJson(json::JsonReader& reader, {{type_name}}& value)
+    {
+		if (reader.peek() != '"')
+		{
+			std::underlying_type_t<{{type_name}}> number{};
+			reader.read(number);
+			value = static_cast<{{type_name}}>(number);
+			return;
+		}
+		const auto parsed = {{ns_package}}::utils::fromString<{{type_name}}>(reader.readStringView());
+		if (!parsed)
+		{
+			reader.fail("unknown {{type_name}} name");
+		}
+		value = *parsed;
     }
 } // namespace {{ns_tpl}}
\ No newline at end of file
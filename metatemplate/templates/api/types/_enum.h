@@ -1,7 +1,18 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
-#include <iostream>
+#include <iosfwd>
+#include <string_view>
+
+#include {{"utils/Enum.h" | util_ns.incl}}
+
+namespace {{ns_package}}::json
+{
+    class JsonWriter;
+    class JsonReader;
+} // namespace {{ns_package}}::json
 
 namespace {{ns_tpl}}
 {
@@ -14,6 +25,72 @@ namespace {{ns_tpl}}
         {{attr|enum.name}} = {{attr|enum.value or loop.index}}{{"," if not loop.last}}
         {%- endfor %}
     };
+} // namespace {{ns_tpl}}
+{% set perfect_hash = type_info|enum.perfect_hash %}
+namespace {{ns_package}}::utils
+{
+	/**
+	 * @brief Name tables of {{ns_tpl}}::{{type_name}}, see Enum.h
+	 */
+	template <>
+	class EnumTraits<{{ns_tpl}}::{{type_name}}>
+	{
+	public:
+		using Enum = {{ns_tpl}}::{{type_name}};
+
+		static constexpr std::size_t COUNT = {{type_info.attrs|length}};
+
+		static constexpr std::array<Enum, COUNT> VALUES{
+            {%- for attr in type_info.attrs %}
+			Enum::{{attr|enum.name}}{{"," if not loop.last}}
+            {%- endfor %}
+		};
+
+		static constexpr std::array<std::string_view, COUNT> NAMES{
+            {%- for attr in type_info.attrs %}
+			"{{attr|enum.name}}"{{"," if not loop.last}}
+            {%- endfor %}
+		};
+
+		static constexpr std::array<std::uint32_t, {{perfect_hash.displacements|length}}> DISPLACEMENTS{
+			{{perfect_hash.displacements|join(", ")}}};
+
+		static constexpr std::array<std::uint32_t, {{perfect_hash.slots|length}}> SLOTS{
+			{{perfect_hash.slots|join(", ")}}};
+
+		/**
+		 * @brief Position of the value in VALUES/NAMES, COUNT when it is not a named value.
+		 * The switch over the dense values compiles down to a subtraction and range check.
+		 */
+		static constexpr std::size_t indexOf(Enum value) noexcept
+		{
+			switch (value)
+			{
+            {%- for attr in type_info.attrs %}
+			case Enum::{{attr|enum.name}}:
+				return {{loop.index0}};
+            {%- endfor %}
+			default:
+				return COUNT;
+			}
+		}
+	};
+} // namespace {{ns_package}}::utils
+
+namespace {{ns_tpl}}
+{
+	/**
+	 * @brief Name of the {{type_name}} value
+	 *
+	 * @param value: the {{type_name}} enum
+	 * @returns the name or an empty view when the value is not a named {{type_name}}
+	 */
+    constexpr std::string_view toStringView({{type_name}} value) noexcept
+    {
+		using Traits = {{ns_package}}::utils::EnumTraits<{{type_name}}>;
+		const auto index = Traits::indexOf(value);
+		return index < Traits::COUNT ? Traits::NAMES[index] : std::string_view();
+    }
 
 	/**
 	 * @brief Output stream operator for the {{type_name}}
@@ -23,4 +100,21 @@ namespace {{ns_tpl}}
 	 * @returns std::ostream
 	 */
     std::ostream& operator<<(std::ostream& os, {{type_name}} value);
+
+	/**
+	 * @brief Writes the {{type_name}} name as a JSON string, unknown values as their number
+	 *
+	 * @param writer: the JSON writer
+	 * @param value: the {{type_name}} enum
+	 */
+    void toJson(json::JsonWriter& writer, {{type_name}} value);
+
+	/**
+	 * @brief Reads a {{type_name}} from its JSON name or number
+	 *
+	 * @param reader: the JSON reader
+	 * @param value: set to the read {{type_name}}
+	 * @throws std::runtime_error if the name is not a {{type_name}}
+	 */
+    void fromJson(json::JsonReader& reader, {{type_name}}& value);
 } // namespace {{ns_tpl}}
\ No newline at end of file
@@ -1,12 +1,23 @@
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
-#include <iostream>
+{%- if cache_serialized %}
+#include <atomic>
+#include <mutex>
+{%- endif %}
+#include <ostream>
+#include <stdexcept>
+#include <string>
 
 {%- if type_info.attrs|select("member.is_floating_point")|list|length %}
 #include {{"utils/EssentiallyEqual.h" | util_ns.incl}}
 {%- endif %}
+#include {{"utils/Hash.h" | util_ns.incl}}
 #include {{"utils/Stream.h" | util_ns.incl}}
 #include {{"byte_stream/ByteStream.h" | util_ns.incl}}
+#include {{"byte_stream/Delta.h" | util_ns.incl}}
+#include {{"byte_stream/FieldBitmap.h" | util_ns.incl}}
+#include {{"json/Json.h" | util_ns.incl}}
 
 {%- set req_attrs = type_info|class.req_attrs %}
 {%- set opt_attrs = type_info|class.opt_attrs %}
@@ -17,6 +28,8 @@
 {%- set imp_class_name = type_info|class.imp_class_name %}
 {%- set imp_name = type_info|class.imp_name %}
 {%- set has_pimpl = ordered_attrs|length %}
+{%- set cached = cache_serialized and has_pimpl %}
+{%- set opt_fields = ordered_attrs|select("member.is_optional_type")|list %}
 
 namespace {{ ns_tpl }}
 {
@@ -54,6 +67,19 @@ namespace {{ ns_tpl }}
         {{attr|member.type_name}} {{attr|member.var_name}}{};
         {%- endfor %}
 
+        {%- if cached %}
+
+        /**
+         * serialized cache, dirty_ is set on modification and turned into a new
+         * revision_ on the next serialization, cache_ holds the bytes of cachedRevision_
+         */
+        mutable std::atomic<bool> dirty_{ true };
+        mutable std::atomic<std::uint64_t> revision_{ 0 };
+        mutable std::mutex cacheMutex_;
+        mutable std::uint64_t cachedRevision_{ 0 };
+        mutable std::vector<std::byte> cache_;
+        {%- endif %}
+
     };
     {%- endif %}
 
@@ -113,6 +139,9 @@ namespace {{ ns_tpl }}
     {{ type_name }}& {{ type_name}}::{{ attr|member.clearer}}()
     {
         {{ imp_name }}->{{ attr|member.var_name }} = std::nullopt;
+        {%- if cached %}
+        {{ imp_name }}->dirty_.store(true, std::memory_order_relaxed);
+        {%- endif %}
         return *this;
     }
 
@@ -120,6 +149,9 @@ namespace {{ ns_tpl }}
     {{ type_name }}& {{ type_name}}::{{ attr|member.setter}}Opt({{ attr|member.type_name}} {{ attr|member.val_name}})
     {
         {{ imp_name }}->{{ attr|member.var_name }} = {{ attr|member.val_name|member.move_wrap(attr)}};
+        {%- if cached %}
+        {{ imp_name }}->dirty_.store(true, std::memory_order_relaxed);
+        {%- endif %}
         return *this;
     }
 
@@ -127,6 +159,9 @@ namespace {{ ns_tpl }}
     {{ type_name }}& {{ type_name}}::{{ attr|member.setter}}({{ attr|member.no_opt_type_name}} {{ attr|member.val_name}})
     {
         {{ imp_name }}->{{ attr|member.var_name }} = {{ attr|member.val_name|member.move_wrap(attr)}};
+        {%- if cached %}
+        {{ imp_name }}->dirty_.store(true, std::memory_order_relaxed);
+        {%- endif %}
         return *this;
     }
     {%- else %}
@@ -134,6 +169,9 @@ namespace {{ ns_tpl }}
     {{ type_name }}& {{ type_name}}::{{ attr|member.setter}}({{ attr|member.type_name}} {{ attr|member.val_name}})
     {
         {{ imp_name }}->{{ attr|member.var_name }} = {{ attr|member.val_name|member.move_wrap(attr)}};
+        {%- if cached %}
+        {{ imp_name }}->dirty_.store(true, std::memory_order_relaxed);
+        {%- endif %}
         return *this;
     }
     
@@ -149,6 +187,9 @@ namespace {{ ns_tpl }}
     {%- if not attr.native_types %}
     {{ attr|member.ref_type_name}} {{ type_name}}::{{ attr|member.getter}}()
     {
+        {%- if cached %}
+        {{ imp_name }}->dirty_.store(true, std::memory_order_relaxed);
+        {%- endif %}
         return {{ imp_name }}->{{ attr|member.var_name }};
     }
 
@@ -196,6 +237,16 @@ namespace {{ ns_tpl }}
 
     void {{ type_name }}::toByteStream(byte_stream::OByteStream& bs) const
     {
+        {%- if cached %}
+        std::lock_guard<std::mutex> lock({{ imp_name }}->cacheMutex_);
+        const auto revision = {{ type_name }}::serializedRevision();
+        if ({{ imp_name }}->cachedRevision_ == revision)
+        {
+            bs.writeBytes({{ imp_name }}->cache_.data(), {{ imp_name }}->cache_.size());
+            return;
+        }
+        const auto begin = bs.size();
+        {%- endif %}
         bs << ID();
         
         {%- for ex in type_info.extensions -%}
@@ -204,16 +255,40 @@ namespace {{ ns_tpl }}
         }
         {%- endfor -%}
 
+        {%- if opt_fields %}
+
+        // one presence bit per optional, only the set values follow
+        byte_stream::FieldBitmap<{{opt_fields|length}}> present;
+        {%- for attr in opt_fields %}
+        present.set({{loop.index0}}, {{ imp_name }}->{{ attr|member.var_name }}.has_value());
+        {%- endfor %}
+        bs << present;
+        {%- endif %}
+
         {%- for attr in ordered_attrs %}
-        {%- if loop.first %}
-        bs
+        {%- if attr is member.is_optional_type %}
+        if ({{ imp_name }}->{{ attr|member.var_name }})
+        {
+            bs << *{{ imp_name }}->{{ attr|member.var_name }};
+        }
+        {%- else %}
+        bs << {{ imp_name }}->{{ attr|member.var_name }};
+        {%- endif %}
+        {%- endfor %}
+
+        {%- if cached %}
+        if (bs.ok())
+        {
+            {{ imp_name }}->cache_.assign(bs.data() + begin, bs.data() + bs.size());
+            {{ imp_name }}->cachedRevision_ = revision;
+        }
         {%- endif %}
-            << {{ imp_name }}->{{ attr|member.var_name }}{%- if loop.last -%};{%- endif -%}
-        {%-endfor %}
     }
 
     void {{ type_name }}::fromByteStream(byte_stream::IByteStream& bs)
     {
+        // fields are read unchecked and validated together below
+        byte_stream::TrustScope deferChecks(bs, byte_stream::IByteStream::Trust::TRUSTED);
         std::remove_const_t<decltype(ID())> id{};
         bs >> id;
         if (id != ID())
@@ -230,20 +305,201 @@ namespace {{ ns_tpl }}
         }
         {%- endfor -%}
 
+        {%- if opt_fields %}
+
+        byte_stream::FieldBitmap<{{opt_fields|length}}> present;
+        bs >> present;
+        {%- endif %}
+
         {%- for attr in ordered_attrs %}
-        {%- if loop.first %}
-        bs
+        {%- if attr is member.is_optional_type %}
+        if (present.test({{opt_fields.index(attr)}}))
+        {
+            bs >> {{ imp_name }}->{{ attr|member.var_name }}.emplace();
+        }
+        else
+        {
+            {{ imp_name }}->{{ attr|member.var_name }}.reset();
+        }
+        {%- else %}
+        bs >> {{ imp_name }}->{{ attr|member.var_name }};
+        {%- endif %}
+        {%- endfor %}
+        {%- if cached %}
+        {{ imp_name }}->dirty_.store(true, std::memory_order_relaxed);
         {%- endif %}
-            >> {{ imp_name }}->{{ attr|member.var_name }}{%- if loop.last -%};{%- endif -%}
-        {%-endfor %}
+        if (deferChecks.previous() == byte_stream::IByteStream::Trust::UNTRUSTED && bs.ok())
+        {
+            validateRestrictions();
+        }
     }
 
+    void {{ type_name }}::validateRestrictions() const
+    {
+        {%- for ex in type_info.extensions %}
+        {{ex|ext.type}}::validateRestrictions();
+        {%- endfor %}
+        {%- for attr in type_info.attrs %}
+        byte_stream::bytestream_impl::validateRestrictions({{ imp_name }}->{{ attr|member.var_name }});
+        {%- endfor %}
+    }
+
+    void {{ type_name }}::toJson(json::JsonWriter& writer) const
+    {
+        writer.beginObject();
+        toJsonFields(writer);
+        writer.endObject();
+    }
+
+    void {{ type_name }}::toJsonFields(json::JsonWriter& {{ "writer" if type_info.attrs or type_info.extensions else "/*writer*/" }}) const
+    {
+        {%- for ex in type_info.extensions %}
+        {{ex|ext.type}}::toJsonFields(writer);
+        {%- endfor %}
+
+        {%- for attr in type_info.attrs %}
+        {%- if attr is member.is_optional_type %}
+        if ({{ imp_name }}->{{ attr|member.var_name }})
+        {
+            writer.key("{{attr.name}}");
+            writer.write(*{{ imp_name }}->{{ attr|member.var_name }});
+        }
+        {%- else %}
+        writer.key("{{attr.name}}");
+        writer.write({{ imp_name }}->{{ attr|member.var_name }});
+        {%- endif %}
+        {%- endfor %}
+    }
+
+    void {{ type_name }}::fromJson(json::JsonReader& reader)
+    {
+        reader.readObject([&](std::string_view key) {
+            if (!fromJsonField(key, reader))
+            {
+                reader.skipValue();
+            }
+        });
+    }
+
+    bool {{ type_name }}::fromJsonField(std::string_view {{ "key" if type_info.attrs or type_info.extensions else "/*key*/" }}, json::JsonReader& {{ "reader" if type_info.attrs or type_info.extensions else "/*reader*/" }})
+    {
+        {%- for attr in type_info.attrs %}
+        if (key == "{{attr.name}}")
+        {
+            {%- if cached %}
+            {{ imp_name }}->dirty_.store(true, std::memory_order_relaxed);
+            {%- endif %}
+            reader.read({{ imp_name }}->{{ attr|member.var_name }});
+            return true;
+        }
+        {%- endfor %}
+
+        {%- for ex in type_info.extensions %}
+        if ({{ex|ext.type}}::fromJsonField(key, reader))
+        {
+            return true;
+        }
+        {%- endfor %}
+        return false;
+    }
+
+    {%- if cache_serialized %}
+
+    std::uint64_t {{ type_name }}::serializedRevision() const noexcept
+    {
+        std::uint64_t revision = 0;
+        {%- if cached %}
+        if ({{ imp_name }}->dirty_.load(std::memory_order_acquire))
+        {
+            {{ imp_name }}->revision_.store(byte_stream::bytestream_impl::nextSerializedRevision(), std::memory_order_relaxed);
+            {{ imp_name }}->dirty_.store(false, std::memory_order_release);
+        }
+        revision = {{ imp_name }}->revision_.load(std::memory_order_relaxed);
+        {%- endif %}
+        {%- for ex in type_info.extensions %}
+        revision = std::max(revision, {{ex|ext.type}}::serializedRevision());
+        {%- endfor %}
+        {%- for attr in type_info.attrs %}
+        revision = std::max(revision, byte_stream::bytestream_impl::serializedRevision({{ imp_name }}->{{ attr|member.var_name }}));
+        {%- endfor %}
+        return revision;
+    }
+
+    void {{ type_name }}::invalidateSerializedCache() noexcept
+    {
+        {%- for ex in type_info.extensions %}
+        {{ex|ext.type}}::invalidateSerializedCache();
+        {%- endfor %}
+        {%- if cached %}
+        {{ imp_name }}->dirty_.store(true, std::memory_order_relaxed);
+        {%- endif %}
+    }
+    {%- endif %}
+
     
+    void {{ type_name }}::encodeDelta(const {{type_name}}& prev, const {{type_name}}& cur, byte_stream::OByteStream& bs)
+    {
+        {%- for ex in type_info.extensions %}
+        {{ex|ext.type}}::encodeDelta(prev, cur, bs);
+        {%- endfor %}
+        {%- if has_pimpl %}
+        byte_stream::FieldBitmap<{{type_info.attrs|length}}> changed;
+        {%- for attr in type_info.attrs %}
+        changed.set({{loop.index0}}, !({{attr|member.equality_check("prev", "cur")}}));
+        {%- endfor %}
+        bs << changed;
+        {%- for attr in type_info.attrs %}
+        if (changed.test({{loop.index0}}))
+        {
+            byte_stream::encodeDelta(prev.{{ imp_name }}->{{ attr|member.var_name }}, cur.{{ imp_name }}->{{ attr|member.var_name }}, bs);
+        }
+        {%- endfor %}
+        {%- endif %}
+    }
+
+    void {{ type_name }}::applyDelta({{type_name}}& value, byte_stream::IByteStream& bs)
+    {
+        {%- for ex in type_info.extensions %}
+        {{ex|ext.type}}::applyDelta(value, bs);
+        {%- endfor %}
+        {%- if has_pimpl %}
+        byte_stream::FieldBitmap<{{type_info.attrs|length}}> changed;
+        bs >> changed;
+        {%- for attr in type_info.attrs %}
+        if (changed.test({{loop.index0}}))
+        {
+            byte_stream::applyDelta(value.{{ imp_name }}->{{ attr|member.var_name }}, bs);
+        }
+        {%- endfor %}
+        {%- if cached %}
+        value.{{ imp_name }}->dirty_.store(true, std::memory_order_relaxed);
+        {%- endif %}
+        {%- endif %}
+    }
+
     std::vector<std::byte> {{ type_name }}::serialize() const
     {
         byte_stream::OByteStream bs;
         bs << *this;
-        return bs.buffer();
+        return bs.release();
+    }
+
+    void {{ type_name }}::serializeInto(std::vector<std::byte>& bytes) const
+    {
+        byte_stream::OByteStream bs(std::move(bytes));
+        bs << *this;
+        bytes = bs.release();
+    }
+
+    std::size_t {{ type_name }}::serializeInto(std::byte* buffer, std::size_t bufferSize) const
+    {
+        byte_stream::OByteStream bs(buffer, bufferSize);
+        bs << *this;
+        if (!bs.ok())
+        {
+            throw std::length_error("{{type_name}} does not fit in a buffer of " + std::to_string(bufferSize) + " bytes");
+        }
+        return bs.size();
     }
 
     {{type_name}} {{type_name}}::deserialize(const void* bufferPtr, std::size_t bufferSize)
@@ -274,6 +530,9 @@ namespace {{ ns_tpl }}
         {%- for attr in type_info.attrs %}
         {{ imp_name }}->{{ attr|member.var_name }} = other.{{ imp_name }}->{{ attr|member.var_name }};
         {%- endfor %}
+        {%- if cached %}
+        {{ imp_name }}->dirty_.store(true, std::memory_order_relaxed);
+        {%- endif %}
 
         return *this;
     }
@@ -297,6 +556,18 @@ namespace {{ ns_tpl }}
     }
     {%- endif %}
 
+    std::size_t {{type_name}}::hash() const noexcept
+    {
+        std::size_t seed = ID();
+        {%- for ex in type_info.extensions %}
+        utils::hashCombine(seed, {{ex|ext.type}}::hash());
+        {%- endfor %}
+        {%- for attr in type_info.attrs %}
+        utils::hashCombine(seed, utils::hashValue({{ imp_name }}->{{ attr|member.var_name }}));
+        {%- endfor %}
+        return seed;
+    }
+
 	bool operator==(const {{type_name}}& lhs, const {{type_name}}& rhs)
 	{
         return
@@ -320,13 +591,8 @@ namespace {{ ns_tpl }}
         if (!{{type_info|class.abstract_parent|attr('name')}}::equals(other)) return false;
         const {{type_name}}& rhs = dynamic_cast<const {{type_name}}&>(other);
         return {{ "true;" if not type_info.attrs }}
-	    {%-   for attr in type_info.attrs -%}
-        {%-     set field_access = attr|member.getter -%}
-	    {%-     if attr is member.is_floating_point %}
-	    utils::EssentiallyEqual({{field_access}}(), rhs.{{field_access}}())
-	    {%-     else %}
-	    {{field_access}}() == rhs.{{field_access}}()
-	    {%-     endif %}
+	    {%-   for attr in type_info|class.equality_ordered_attrs %}
+	    {{attr|member.equality_check("(*this)", "rhs")}}
         {{" &&" if not loop.last else ";"}}
         {%-   endfor %}
     }
@@ -1,6 +1,12 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
 #include <memory>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 {%- for ex in type_info.extensions %}
@@ -21,6 +27,12 @@ namespace {{ns_package}}::byte_stream
     class IByteStream;
 } // namespace {{ns_package}}::byte_stream
 
+namespace {{ns_package}}::json
+{
+    class JsonWriter;
+    class JsonReader;
+} // namespace {{ns_package}}::json
+
 namespace {{ns_tpl}}
 {
     {%- for fwd_decl in type_info.attrs|select('member.can_fwd_decl')|map('member.fwd_decl')|sort|unique %}
@@ -258,11 +270,25 @@ namespace {{ns_tpl}}
          */
         void toByteStream(byte_stream::OByteStream& bs) const;
         /**
-         * @brief Reads the structure from a byte stream
+         * @brief Reads the structure from a byte stream. Unless the stream is trusted, the
+         * restrictions of every aliased field are checked in one pass once all are read.
          *
          * @param bs The bytestream.
          */
         void fromByteStream(byte_stream::IByteStream& bs);
+
+        /**
+         * @brief Checks the restrictions of every aliased field, nested structs included
+         *
+         * @throws std::invalid_argument from the first field failing its restrictions
+         */
+        {%- if type_info is class.extends_abstract %}
+        void validateRestrictions() const override;
+        {%- elif type_info is class.is_abstract %}
+        virtual void validateRestrictions() const;
+        {%- else %}
+        void validateRestrictions() const;
+        {%- endif %}
         /**
          * @brief Serializes the object
          *
@@ -270,6 +296,23 @@ namespace {{ns_tpl}}
          */
         [[nodiscard]] std::vector<std::byte> serialize() const;
 
+        /**
+         * @brief Serializes the object into bytes, reusing their capacity
+         *
+         * @param bytes: replaced with the serialized object
+         */
+        void serializeInto(std::vector<std::byte>& bytes) const;
+
+        /**
+         * @brief Serializes the object straight into a caller provided buffer, no copy
+         *
+         * @param buffer: the buffer to write to
+         * @param bufferSize: size of the buffer
+         * @return number of bytes written
+         * @throws std::length_error if the buffer is too small, its content is then unspecified
+         */
+        std::size_t serializeInto(std::byte* buffer, std::size_t bufferSize) const;
+
         /**
          * @brief Serializes the object
          *
@@ -284,6 +327,106 @@ namespace {{ns_tpl}}
          */
         [[nodiscard]] static {{type_name}} deserialize(const std::vector<std::byte>& bytes);
 
+        /**
+         * @brief Writes the fields changed from prev to cur (per operator==), nested
+         * structs and lists are written as deltas themselves.
+         *
+         * @param prev: the value the reader holds
+         * @param cur: the new value
+         * @param bs The bytestream.
+         */
+        static void encodeDelta(const {{type_name}}& prev, const {{type_name}}& cur, byte_stream::OByteStream& bs);
+
+        /**
+         * @brief Applies a delta written by encodeDelta
+         *
+         * @param value: the object to update, must hold the prev value of the delta
+         * @param bs The bytestream.
+         */
+        static void applyDelta({{type_name}}& value, byte_stream::IByteStream& bs);
+
+        /**
+         * @brief Writes the structure as a JSON object
+         *
+         * @param writer The JSON writer.
+         */
+        void toJson(json::JsonWriter& writer) const;
+
+        /**
+         * @brief Writes the fields of the structure and its bases into the open JSON object
+         *
+         * @param writer The JSON writer.
+         */
+        void toJsonFields(json::JsonWriter& writer) const;
+
+        /**
+         * @brief Reads the structure from a JSON object, unknown keys are skipped and
+         * missing fields keep their value
+         *
+         * @param reader The JSON reader.
+         */
+        void fromJson(json::JsonReader& reader);
+
+        /**
+         * @brief Reads the value of one key of a JSON object
+         *
+         * @param key: the object key
+         * @param reader The JSON reader.
+         * @return false if the key is not a field of the structure or its bases
+         */
+        bool fromJsonField(std::string_view key, json::JsonReader& reader);
+
+        /**
+         * @brief Hash of the object, consistent with operator==
+         *
+         * @note floating point fields are not hashed since equality is ULP tolerant,
+         * polymorphic fields hash by pointer like they compare.
+         *
+         * @return std::size_t
+         */
+        {%- if type_info is class.extends_abstract %}
+        [[nodiscard]] std::size_t hash() const noexcept override;
+        {%- elif type_info is class.is_abstract %}
+        [[nodiscard]] virtual std::size_t hash() const noexcept;
+        {%- else %}
+        [[nodiscard]] std::size_t hash() const noexcept;
+        {%- endif %}
+
+        {%- if cache_serialized %}
+
+        /**
+         * @brief Revision of the serialized form, the newest modification of this object,
+         * its parents or any nested struct. toByteStream reuses the cached bytes while it
+         * is unchanged.
+         *
+         * @return std::uint64_t
+         */
+        {%- if type_info is class.extends_abstract %}
+        [[nodiscard]] std::uint64_t serializedRevision() const noexcept override;
+        {%- elif type_info is class.is_abstract %}
+        [[nodiscard]] virtual std::uint64_t serializedRevision() const noexcept;
+        {%- else %}
+        [[nodiscard]] std::uint64_t serializedRevision() const noexcept;
+        {%- endif %}
+
+        /**
+         * @brief Drops the cached serialized bytes
+         *
+         * @note only needed if a container member was modified through a reference
+         * kept from before the last serialization, setters and getters track the rest.
+         */
+        void invalidateSerializedCache() noexcept;
+        {%- endif %}
+
+        /**
+         * @brief Abseil hash support, see https://abseil.io/docs/cpp/guides/hash
+         */
+        template <typename H>
+        friend H AbslHashValue(H h, const {{type_name}}& {{type_name|names.val_name}})
+        {
+            return H::combine(std::move(h), {{type_name|names.val_name}}.hash());
+        }
+
     {% if type_info.attrs %}
     private:
         /**
@@ -323,3 +466,18 @@ namespace {{ns_tpl}}
     std::ostream& operator<<(std::ostream& os, const {{type_name}}& {{type_name|names.val_name}});
 
 } // namespace {{ns_tpl}}
+
+/**
+ * @brief std::hash support for {{type_name}}, allows use in unordered containers
+ */
+namespace std
+{
+    template <>
+    struct hash<{{ns_tpl}}::{{type_name}}>
+    {
+        std::size_t operator()(const {{ns_tpl}}::{{type_name}}& value) const noexcept
+        {
+            return value.hash();
+        }
+    };
+} // namespace std
@@ -1,4 +1,8 @@
+#include <stdexcept>
+#include <string>
+
 #include {{"byte_stream/ByteStream.h" | util_ns.incl}}
+#include {{"json/Json.h" | util_ns.incl}}
 
 {%- for subclass in derived %}
 #include {{subclass.name | class_name.include}}
@@ -43,4 +47,51 @@ void {{type_name}}AbstractFactoryImpl::to_stream(std::shared_ptr<{{type_name}}>
     }
 }
 
+// a one key object naming the type, {"<Type>": {...}}, or null
+std::shared_ptr<{{type_name}}> {{type_name}}AbstractFactoryImpl::from_json(json::JsonReader& reader)
+{
+    if (reader.readNull()) return {};
+
+    std::shared_ptr<{{type_name}}> obj;
+    reader.readObject([&](std::string_view key) {
+        if (obj) {
+            reader.fail("expected one type key for {{type_name}}");
+        }
+        {%- for subclass in derived %}
+        {{ "else " if not loop.first }}if (key == "{{subclass.name}}") {
+            auto sc = std::make_shared<{{subclass.name}}>();
+            reader.read(*sc);
+            obj = std::move(sc);
+        }
+        {%- endfor %}
+        else {
+            reader.fail("unknown type for {{type_name}}");
+        }
+    });
+    if (!obj) {
+        reader.fail("expected a type key for {{type_name}}");
+    }
+    return obj;
+}
+
+void {{type_name}}AbstractFactoryImpl::to_json(const std::shared_ptr<{{type_name}}>& obj, json::JsonWriter& writer)
+{
+    if (!obj) {
+        writer.writeNull();
+        return;
+    }
+    const auto id = obj->abstractId();
+    {%- for subclass in derived %}
+    {{ "else " if not loop.first }}if ( id == {{subclass.name}}::ID()) {
+        writer.beginObject();
+        writer.key("{{subclass.name}}");
+        writer.write(*std::dynamic_pointer_cast<{{subclass.name}}>(obj));
+        writer.endObject();
+    }
+    {%- endfor %}
+    else {
+        throw std::runtime_error("ID: " + std::to_string(id) + " Invalid for {{type_name}}");
+    }
+}
+
 } // namespace {{ ns_tpl }}
\ No newline at end of file
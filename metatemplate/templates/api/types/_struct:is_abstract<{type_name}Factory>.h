@@ -1,6 +1,5 @@
 #pragma once
 
-#include <iostream>
 #include <memory>
 
 #include "AbstractFactory.h"
@@ -13,12 +12,20 @@ namespace {{ns_package}}::byte_stream
     class IByteStream;
 }
 
+namespace {{ns_package}}::json
+{
+    class JsonWriter;
+    class JsonReader;
+}
+
 namespace {{ ns_tpl }} {
 
     class {{type_name}}AbstractFactoryImpl {
         public:
             static std::shared_ptr<{{type_name}}> from_stream(byte_stream::IByteStream& bs);
             static void to_stream(std::shared_ptr<{{type_name}}> obj, byte_stream::OByteStream& bs);
+            static std::shared_ptr<{{type_name}}> from_json(json::JsonReader& reader);
+            static void to_json(const std::shared_ptr<{{type_name}}>& obj, json::JsonWriter& writer);
     };
 
     template<>
@@ -0,0 +1,138 @@
+{%- set req_attrs = type_info|class.req_attrs %}
+{%- set opt_attrs = type_info|class.opt_attrs %}
+{%- set inherited_attrs = type_info|class.inherited_attrs|dict.values|sum(start=[]) %}
+{%- set all_attrs = inherited_attrs + req_attrs + opt_attrs -%}
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include {{"byte_stream/ByteStream.h" | util_ns.incl}}
+
+#include "{{type_name}}Columns.h"
+
+namespace {{ns_tpl}}
+{
+    std::size_t {{type_name}}Columns::size() const noexcept
+    {
+        return size_;
+    }
+
+    bool {{type_name}}Columns::empty() const noexcept
+    {
+        return size_ == 0;
+    }
+
+    void {{type_name}}Columns::reserve(std::size_t count)
+    {
+        {%- for attr in all_attrs %}
+        {{attr|member.var_name}}.reserve(count);
+        {%- endfor %}
+    }
+
+    void {{type_name}}Columns::clear() noexcept
+    {
+        {%- for attr in all_attrs %}
+        {{attr|member.var_name}}.clear();
+        {%- endfor %}
+        size_ = 0;
+    }
+
+    void {{type_name}}Columns::push_back(const value_type& value)
+    {
+        {%- if all_attrs %}
+        try
+        {
+            {%- for attr in all_attrs %}
+            {{attr|member.var_name}}.push_back(value.{{attr|member.getter}}());
+            {%- endfor %}
+        }
+        catch(...)
+        {
+            // drop the fields appended before the throwing copy
+            {%- for attr in all_attrs %}
+            if({{attr|member.var_name}}.size() > size_)
+            {
+                {{attr|member.var_name}}.pop_back();
+            }
+            {%- endfor %}
+            throw;
+        }
+        {%- endif %}
+        ++size_;
+    }
+
+    {{type_name}}Columns::Reference {{type_name}}Columns::operator[](std::size_t index) noexcept
+    {
+        return Reference(*this, index);
+    }
+
+    {{type_name}}Columns::ConstReference {{type_name}}Columns::operator[](std::size_t index) const noexcept
+    {
+        return ConstReference(*this, index);
+    }
+
+    {{type_name}} {{type_name}}Columns::get(std::size_t index) const
+    {
+        if(index >= size_)
+        {
+            throw std::out_of_range("{{type_name}}Columns index " + std::to_string(index)
+                + " out of range for size " + std::to_string(size_));
+        }
+        {{type_name}} value;
+        {%- for attr in all_attrs %}
+        value.{{attr|member.setter}}{{"Opt" if attr is member.is_optional_type}}({{attr|member.var_name}}[index]);
+        {%- endfor %}
+        return value;
+    }
+    {%- for attr in all_attrs %}
+
+    const std::vector<{{attr|member.type_name}}>& {{type_name}}Columns::{{attr|member.val_name}}Column() const noexcept
+    {
+        return {{attr|member.var_name}};
+    }
+    {%- endfor %}
+
+    void {{type_name}}Columns::toByteStream(byte_stream::OByteStream& bs) const
+    {
+        bs << {{type_name}}::ID();
+        bs << static_cast<std::uint64_t>(size_);
+        {%- for attr in all_attrs %}
+        bs << {{attr|member.var_name}};
+        {%- endfor %}
+    }
+
+    void {{type_name}}Columns::fromByteStream(byte_stream::IByteStream& bs)
+    {
+        // columns are read unchecked and validated column by column below
+        byte_stream::TrustScope deferChecks(bs, byte_stream::IByteStream::Trust::TRUSTED);
+        std::remove_const_t<decltype({{type_name}}::ID())> id{};
+        bs >> id;
+        if(id != {{type_name}}::ID())
+        {
+            throw std::runtime_error("ID:" + std::to_string(id)
+                + " of the bytestream does not match the class ID: "
+                + std::to_string({{type_name}}::ID())
+                + " for columns {{type_name}}Columns");
+        }
+
+        std::uint64_t count{};
+        bs >> count;
+        {{type_name}}Columns columns;
+        {%- for attr in all_attrs %}
+        bs >> columns.{{attr|member.var_name}};
+        if(columns.{{attr|member.var_name}}.size() != count)
+        {
+            throw std::runtime_error("{{type_name}}Columns {{attr|member.val_name}} has "
+                + std::to_string(columns.{{attr|member.var_name}}.size()) + " values for "
+                + std::to_string(count) + " elements");
+        }
+        {%- endfor %}
+        if (deferChecks.previous() == byte_stream::IByteStream::Trust::UNTRUSTED && bs.ok())
+        {
+            {%- for attr in all_attrs %}
+            byte_stream::bytestream_impl::validateRestrictions(columns.{{attr|member.var_name}});
+            {%- endfor %}
+        }
+        columns.size_ = static_cast<std::size_t>(count);
+        *this = std::move(columns);
+    }
+} // namespace {{ns_tpl}}
@@ -0,0 +1,148 @@
+{%- set req_attrs = type_info|class.req_attrs %}
+{%- set opt_attrs = type_info|class.opt_attrs %}
+{%- set inherited_attrs = type_info|class.inherited_attrs|dict.values|sum(start=[]) %}
+{%- set all_attrs = inherited_attrs + req_attrs + opt_attrs -%}
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "{{type_name}}_cpp.h"
+
+namespace {{ns_package}}::byte_stream
+{
+    class OByteStream;
+    class IByteStream;
+} // namespace {{ns_package}}::byte_stream
+
+namespace {{ns_tpl}}
+{
+    /**
+     * @brief Struct of arrays container of {{type_name}}, one contiguous vector per field
+     * (inherited fields included) instead of one heap allocated object per element.
+     * Per field scans go through the column accessors, elements through the
+     * reference proxies of operator[].
+     */
+    class {{type_name}}Columns
+    {
+    public:
+        using value_type = {{type_name}};
+
+        /**
+         * @brief Proxy to the element at an index, getters and setters mirror {{type_name}}
+         *
+         * @tparam Columns: {{type_name}}Columns or const {{type_name}}Columns (no setters)
+         */
+        template <typename Columns>
+        class BasicReference
+        {
+        public:
+            BasicReference(Columns& columns, std::size_t index) noexcept : columns_(&columns), index_(index)
+            {
+            }
+
+            [[nodiscard]] std::size_t index() const noexcept
+            {
+                return index_;
+            }
+            {%- for attr in all_attrs %}
+
+            [[nodiscard]] typename std::vector<{{attr|member.type_name}}>::const_reference {{attr|member.getter}}() const
+            {
+                return columns_->{{attr|member.var_name}}[index_];
+            }
+
+            void {{attr|member.setter}}{{"Opt" if attr is member.is_optional_type}}({{attr|member.type_name}} {{attr|member.val_name}}) const
+            {
+                static_assert(!std::is_const_v<Columns>, "setting a field through a const reference");
+                columns_->{{attr|member.var_name}}[index_] = std::move({{attr|member.val_name}});
+            }
+            {%- endfor %}
+
+            /**
+             * @brief Copies the element out
+             *
+             * @return {{type_name}}
+             */
+            [[nodiscard]] value_type get() const
+            {
+                return columns_->get(index_);
+            }
+
+        private:
+            Columns* columns_;
+            std::size_t index_;
+        };
+
+        using Reference = BasicReference<{{type_name}}Columns>;
+        using ConstReference = BasicReference<const {{type_name}}Columns>;
+
+        [[nodiscard]] std::size_t size() const noexcept;
+
+        [[nodiscard]] bool empty() const noexcept;
+
+        /**
+         * @brief Reserves every column for count elements
+         */
+        void reserve(std::size_t count);
+
+        void clear() noexcept;
+
+        /**
+         * @brief Appends the fields of value to every column, the columns are left
+         * unchanged if a copy throws
+         */
+        void push_back(const value_type& value);
+
+        /**
+         * @brief Unchecked element access
+         */
+        [[nodiscard]] Reference operator[](std::size_t index) noexcept;
+
+        /**
+         * @brief Unchecked element access
+         */
+        [[nodiscard]] ConstReference operator[](std::size_t index) const noexcept;
+
+        /**
+         * @brief Copies the element at index out
+         *
+         * @throws std::out_of_range if index >= size()
+         * @return {{type_name}}
+         */
+        [[nodiscard]] value_type get(std::size_t index) const;
+        {%- for attr in all_attrs %}
+
+        /**
+         * @brief All {{attr|member.val_name}} values, contiguous and in element order
+         *
+         * @return const std::vector<{{attr|member.type_name}}>&
+         */
+        [[nodiscard]] const std::vector<{{attr|member.type_name}}>& {{attr|member.val_name}}Column() const noexcept;
+        {%- endfor %}
+
+        /**
+         * @brief Writes the element count and then every column as a whole, fixed size
+         * columns are bulk copied.
+         *
+         * @param bs: the byte stream to write to
+         */
+        void toByteStream(byte_stream::OByteStream& bs) const;
+
+        /**
+         * @brief Replaces the content with the columns written by toByteStream
+         *
+         * @param bs: the byte stream to read from
+         * @throws std::runtime_error if the stream holds other columns or their sizes differ
+         */
+        void fromByteStream(byte_stream::IByteStream& bs);
+
+    private:
+        {%- for attr in all_attrs %}
+        std::vector<{{attr|member.type_name}}> {{attr|member.var_name}};
+        {%- endfor %}
+        std::size_t size_ = 0;
+    };
+} // namespace {{ns_tpl}}
@@ -1,7 +1,11 @@
+#include <ostream>
 #include <stdexcept>
+#include <string>
 
+#include {{"utils/Hash.h" | util_ns.incl}}
 #include {{"utils/Stream.h" | util_ns.incl}}
 #include {{"byte_stream/ByteStream.h" | util_ns.incl}}
+#include {{"json/Json.h" | util_ns.incl}}
 
 {%- for header in type_info|variant.cpp_includes %}
 #include {{header}}
@@ -103,6 +107,7 @@ namespace {{ns_tpl}}
 
     void {{type_name}}::fromByteStream(byte_stream::IByteStream& bs)
     {
+        byte_stream::TrustScope deferChecks(bs, byte_stream::IByteStream::Trust::TRUSTED);
         bs >> choice_;
         switch(choice_)
         {
@@ -112,6 +117,15 @@ namespace {{ns_tpl}}
                 break;
         {%- endfor %}
         }
+        if (deferChecks.previous() == byte_stream::IByteStream::Trust::UNTRUSTED && bs.ok())
+        {
+            validateRestrictions();
+        }
+    }
+
+    void {{type_name}}::validateRestrictions() const
+    {
+        byte_stream::bytestream_impl::validateRestrictions(value_);
     }
 
     {%- for choice in type_info|variant.choices %}
@@ -123,6 +137,63 @@ namespace {{ns_tpl}}
     }
     {%- endfor %}
 
+    void {{type_name}}::toJson(json::JsonWriter& writer) const
+    {
+        writer.beginObject();
+        switch(choice_)
+        {
+        {%- for choice in type_info|variant.choices %}
+            case Choice::{{choice.name}}:
+                writer.key("{{choice.name}}");
+                writer.write(get{{choice.name}}());
+                break;
+        {%- endfor %}
+        }
+        writer.endObject();
+    }
+
+    void {{type_name}}::fromJson(json::JsonReader& reader)
+    {
+        bool read = false;
+        reader.readObject([&](std::string_view key) {
+            if (read)
+            {
+                reader.fail("expected one choice key for {{type_name}}");
+            }
+            {%- for choice in type_info|variant.choices %}
+            {{ "else " if not loop.first }}if (key == "{{choice.name}}")
+            {
+                {{choice.type}} instance{};
+                reader.read(instance);
+                set{{choice.name}}({{ "instance"|member.move_wrap(choice.as_attr) }});
+            }
+            {%- endfor %}
+            else
+            {
+                reader.fail("unknown choice for {{type_name}}");
+            }
+            read = true;
+        });
+        if (!read)
+        {
+            reader.fail("expected a choice key for {{type_name}}");
+        }
+    }
+
+    std::size_t {{type_name}}::hash() const noexcept
+    {
+        std::size_t seed = static_cast<std::size_t>(choice_);
+        utils::hashCombine(seed, utils::hashValue(value_));
+        return seed;
+    }
+    {%- if cache_serialized %}
+
+    std::uint64_t {{type_name}}::serializedRevision() const noexcept
+    {
+        return byte_stream::bytestream_impl::serializedRevision(value_);
+    }
+    {%- endif %}
+
 	bool operator==(const {{type_name}}& lhs, const {{type_name}}& rhs)
 	{
 	    return lhs.heldChoice() == rhs.heldChoice() && lhs.heldValue() == rhs.heldValue();
@@ -1,7 +1,14 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+#include <utility>
 #include <variant>
-#include <iostream>
+#include <vector>
 
 {%- for header in type_info|variant.includes %}
 #include {{header|incl.quote_fix(path_package)}}
@@ -13,6 +20,12 @@ namespace {{ns_package}}::byte_stream
     class IByteStream;
 }
 
+namespace {{ns_package}}::json
+{
+    class JsonWriter;
+    class JsonReader;
+}
+
 {%- set variant_types = type_info|variant.choices|map(attribute='type')|sort|unique|list -%}
 
 namespace {{ns_tpl}}
@@ -123,6 +136,53 @@ namespace {{ns_tpl}}
          */
         void fromByteStream(byte_stream::IByteStream& bs);
 
+        /**
+         * @brief Checks the restrictions of the held value
+         *
+         * @throws std::invalid_argument if the held value fails its restrictions
+         */
+        void validateRestrictions() const;
+
+        /**
+         * @brief Writes the variant as a one key JSON object, {"<Choice>": value}
+         *
+         * @param writer The JSON writer.
+         */
+        void toJson(json::JsonWriter& writer) const;
+
+        /**
+         * @brief Reads the variant from a one key JSON object
+         *
+         * @param reader The JSON reader.
+         */
+        void fromJson(json::JsonReader& reader);
+
+        /**
+         * @brief Hash of the held choice and value, consistent with operator==
+         *
+         * @return std::size_t
+         */
+        [[nodiscard]] std::size_t hash() const noexcept;
+
+        /**
+         * @brief Abseil hash support, see https://abseil.io/docs/cpp/guides/hash
+         */
+        template <typename H>
+        friend H AbslHashValue(H h, const {{type_name}}& value)
+        {
+            return H::combine(std::move(h), value.hash());
+        }
+        {%- if cache_serialized %}
+
+        /**
+         * @brief Newest serialized revision of the held value, lets a struct holding this
+         * variant notice edits to a struct held in it
+         *
+         * @return std::uint64_t
+         */
+        [[nodiscard]] std::uint64_t serializedRevision() const noexcept;
+        {%- endif %}
+
     private:
         Choice choice_{ Choice::{{type_info|variant.default|attr('name')}} };
         ChoiceTypes value_ = {{type_info|variant.default|attr('type')}}{};
@@ -163,4 +223,16 @@ namespace {{ns_tpl}}
 	 * @returns std::ostream
 	 */
     std::ostream& operator<<(std::ostream& os, const {{type_name}}& value);
-} // namespace {{ns_tpl}}
\ No newline at end of file
+} // namespace {{ns_tpl}}
+
+namespace std
+{
+    template <>
+    struct hash<{{ns_tpl}}::{{type_name}}>
+    {
+        std::size_t operator()(const {{ns_tpl}}::{{type_name}}& value) const noexcept
+        {
+            return value.hash();
+        }
+    };
+} // namespace std
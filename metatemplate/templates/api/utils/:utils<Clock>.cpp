@@ -0,0 +1,275 @@
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <ostream>
+
+#include "Clock.h"
+
+namespace {{ns_tpl}}
+{
+	namespace clock_impl
+	{
+		constexpr std::int64_t NANOS_PER_SECOND = Duration::period::den;
+		constexpr std::int64_t SECONDS_PER_DAY = 86400;
+		constexpr unsigned FRACTION_DIGITS = 9;
+
+		/**
+		 * @brief "00" to "99", two digits are written with one copy
+		 */
+		struct DigitPairs
+		{
+			char chars[200];
+
+			constexpr DigitPairs() : chars{}
+			{
+				for(unsigned i = 0; i < 100; ++i)
+				{
+					chars[i * 2] = static_cast<char>('0' + i / 10);
+					chars[i * 2 + 1] = static_cast<char>('0' + i % 10);
+				}
+			}
+		};
+
+		constexpr DigitPairs DIGIT_PAIRS{};
+
+		inline char* writeTwoDigits(char* out, unsigned value) noexcept
+		{
+			std::memcpy(out, DIGIT_PAIRS.chars + value * 2, 2);
+			return out + 2;
+		}
+
+		/**
+		 * @brief Reads exactly count digits
+		 */
+		inline bool readDigits(const char*& it, const char* last, unsigned count, unsigned& value) noexcept
+		{
+			if(last - it < static_cast<std::ptrdiff_t>(count))
+			{
+				return false;
+			}
+			value = 0;
+			for(const auto end = it + count; it != end; ++it)
+			{
+				const auto digit = static_cast<unsigned>(*it - '0');
+				if(digit > 9)
+				{
+					return false;
+				}
+				value = value * 10 + digit;
+			}
+			return true;
+		}
+
+		inline bool readChar(const char*& it, const char* last, char expected) noexcept
+		{
+			if(it == last || *it != expected)
+			{
+				return false;
+			}
+			++it;
+			return true;
+		}
+
+		// civil date <-> days since 1970-01-01 in the proleptic gregorian calendar,
+		// see http://howardhinnant.github.io/date_algorithms.html
+		constexpr void civilFromDays(std::int64_t days, std::int64_t& year, unsigned& month, unsigned& day) noexcept
+		{
+			days += 719468;
+			const std::int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+			const auto dayOfEra = static_cast<unsigned>(days - era * 146097);
+			const unsigned yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+			const unsigned dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+			const unsigned monthIndex = (5 * dayOfYear + 2) / 153;
+			day = dayOfYear - (153 * monthIndex + 2) / 5 + 1;
+			month = monthIndex < 10 ? monthIndex + 3 : monthIndex - 9;
+			year = static_cast<std::int64_t>(yearOfEra) + era * 400 + (month <= 2 ? 1 : 0);
+		}
+
+		constexpr std::int64_t daysFromCivil(std::int64_t year, unsigned month, unsigned day) noexcept
+		{
+			year -= month <= 2 ? 1 : 0;
+			const std::int64_t era = (year >= 0 ? year : year - 399) / 400;
+			const auto yearOfEra = static_cast<unsigned>(year - era * 400);
+			const unsigned dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+			const unsigned dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+			return era * 146097 + static_cast<std::int64_t>(dayOfEra) - 719468;
+		}
+
+		constexpr unsigned daysInMonth(unsigned year, unsigned month) noexcept
+		{
+			if(month == 2)
+			{
+				const bool leap = year % 4 == 0 && (year % 100 != 0 || year % 400 == 0);
+				return leap ? 29 : 28;
+			}
+			return month == 4 || month == 6 || month == 9 || month == 11 ? 30 : 31;
+		}
+	} // namespace clock_impl
+
+	char* toChars(const TimePoint& timePoint, char* out) noexcept
+	{
+		using namespace clock_impl;
+
+		// floor division so times before the epoch count back from the previous second/day
+		const auto count = timePoint.time_since_epoch().count();
+		auto seconds = count / NANOS_PER_SECOND;
+		auto nanos = count % NANOS_PER_SECOND;
+		if(nanos < 0)
+		{
+			nanos += NANOS_PER_SECOND;
+			--seconds;
+		}
+		auto days = seconds / SECONDS_PER_DAY;
+		auto secondOfDay = seconds % SECONDS_PER_DAY;
+		if(secondOfDay < 0)
+		{
+			secondOfDay += SECONDS_PER_DAY;
+			--days;
+		}
+
+		std::int64_t year;
+		unsigned month;
+		unsigned day;
+		civilFromDays(days, year, month, day);
+
+		// a nanosecond TimePoint spans the years 1677 to 2262, always 4 digits
+		out = writeTwoDigits(out, static_cast<unsigned>(year / 100));
+		out = writeTwoDigits(out, static_cast<unsigned>(year % 100));
+		*out++ = '-';
+		out = writeTwoDigits(out, month);
+		*out++ = '-';
+		out = writeTwoDigits(out, day);
+		*out++ = 'T';
+		const auto second = static_cast<unsigned>(secondOfDay);
+		out = writeTwoDigits(out, second / 3600);
+		*out++ = ':';
+		out = writeTwoDigits(out, second / 60 % 60);
+		*out++ = ':';
+		out = writeTwoDigits(out, second % 60);
+
+		if(nanos > 0)
+		{
+			auto fraction = static_cast<unsigned>(nanos);
+			auto digits = FRACTION_DIGITS;
+			while(fraction % 10 == 0)
+			{
+				fraction /= 10;
+				--digits;
+			}
+			*out = '.';
+			for(auto i = digits; i > 0; --i)
+			{
+				out[i] = static_cast<char>('0' + fraction % 10);
+				fraction /= 10;
+			}
+			out += digits + 1;
+		}
+		*out++ = 'Z';
+		return out;
+	}
+
+	const char* fromChars(const char* first, const char* last, TimePoint& timePoint) noexcept
+	{
+		using namespace clock_impl;
+
+		unsigned year, month, day, hour, minute, second;
+		auto it = first;
+		if(!readDigits(it, last, 4, year) || !readChar(it, last, '-') || !readDigits(it, last, 2, month)
+			|| !readChar(it, last, '-') || !readDigits(it, last, 2, day) || !readChar(it, last, 'T')
+			|| !readDigits(it, last, 2, hour) || !readChar(it, last, ':') || !readDigits(it, last, 2, minute)
+			|| !readChar(it, last, ':') || !readDigits(it, last, 2, second))
+		{
+			return nullptr;
+		}
+		if(month < 1 || month > 12 || day < 1 || day > daysInMonth(year, month) || hour > 23 || minute > 59
+			|| second > 59)
+		{
+			return nullptr;
+		}
+
+		std::int64_t nanos = 0;
+		if(it != last && *it == '.')
+		{
+			++it;
+			unsigned digits = 0;
+			for(; it != last && static_cast<unsigned>(*it - '0') <= 9; ++it, ++digits)
+			{
+				if(digits < FRACTION_DIGITS)
+				{
+					nanos = nanos * 10 + (*it - '0');
+				}
+			}
+			if(digits == 0)
+			{
+				return nullptr;
+			}
+			for(; digits < FRACTION_DIGITS; ++digits)
+			{
+				nanos *= 10;
+			}
+		}
+
+		std::int64_t offset = 0;
+		if(it == last)
+		{
+			return nullptr;
+		}
+		if(*it == 'Z')
+		{
+			++it;
+		}
+		else if(*it == '+' || *it == '-')
+		{
+			const std::int64_t sign = *it++ == '+' ? 1 : -1;
+			unsigned offsetHour, offsetMinute;
+			if(!readDigits(it, last, 2, offsetHour) || !readChar(it, last, ':') || !readDigits(it, last, 2, offsetMinute)
+				|| offsetHour > 23 || offsetMinute > 59)
+			{
+				return nullptr;
+			}
+			offset = sign * static_cast<std::int64_t>(offsetHour * 3600 + offsetMinute * 60);
+		}
+		else
+		{
+			return nullptr;
+		}
+
+		const auto seconds = daysFromCivil(year, month, day) * SECONDS_PER_DAY + hour * 3600 + minute * 60 + second - offset;
+		// before the epoch count the fraction back from the next second so the last
+		// representable second in each direction does not overflow
+		constexpr auto MAX = std::numeric_limits<Duration::rep>::max();
+		constexpr auto MIN = std::numeric_limits<Duration::rep>::min();
+		const auto whole = seconds < 0 && nanos > 0 ? seconds + 1 : seconds;
+		if(whole > MAX / NANOS_PER_SECOND || whole < MIN / NANOS_PER_SECOND)
+		{
+			return nullptr;
+		}
+		const auto base = whole * NANOS_PER_SECOND;
+		if(whole != seconds)
+		{
+			nanos -= NANOS_PER_SECOND;
+		}
+		if((base > 0 && nanos > MAX - base) || (base < 0 && nanos < MIN - base))
+		{
+			return nullptr;
+		}
+		timePoint = TimePoint{Duration{base + nanos}};
+		return it;
+	}
+
+	std::string toStr(const TimePoint& timePoint) noexcept
+	{
+		char chars[TIME_POINT_CHARS];
+		return std::string(chars, toChars(timePoint, chars));
+	}
+
+	std::ostream& operator<<(std::ostream& os, const Duration duration)
+	{
+		return os << duration.count() << " nanoseconds";
+	}
+
+	std::ostream& operator<<(std::ostream& os, const TimePoint& timepoint)
+	{
+		return os << timepoint.time_since_epoch() << " nanoseconds since epoch";
+	}
+} // namespace {{ns_tpl}}
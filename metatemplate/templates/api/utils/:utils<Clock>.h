@@ -1,9 +1,9 @@
 #pragma once
 
 #include <chrono>
-#include <iostream>
-#include <iomanip>
-#include <sstream>
+#include <cstddef>
+#include <iosfwd>
+#include <string>
 
 namespace {{ns_tpl}}
 {
@@ -22,48 +22,39 @@ namespace {{ns_tpl}}
 	 */
 	using TimePoint = std::chrono::time_point<Clock, Duration>;
 
+	/**
+	 * @brief The most characters toChars writes, "YYYY-MM-DDTHH:MM:SS.nnnnnnnnnZ"
+	 */
+	inline constexpr std::size_t TIME_POINT_CHARS = 30;
+
+	/**
+	 * @brief Writes the time point as an ISO-8601 UTC string, trailing zeros of the
+	 * fractional seconds are dropped and the fraction is left off when it is zero.
+	 *
+	 * @param timePoint: the time point to write
+	 * @param out: the output, at least TIME_POINT_CHARS long, not null terminated
+	 * @returns char* one past the last character written
+	 */
+	char* toChars(const TimePoint& timePoint, char* out) noexcept;
+
+	/**
+	 * @brief Parses an ISO-8601 "YYYY-MM-DDTHH:MM:SS[.f]Z" or "...[.f]+HH:MM" string,
+	 * fractional seconds past nanoseconds are truncated.
+	 *
+	 * @param first: the start of the string
+	 * @param last: the end of the string
+	 * @param timePoint: set to the parsed time point on success
+	 * @returns const char* one past the last character parsed, or nullptr if the string
+	 * is not a valid time point (timePoint is then unchanged)
+	 */
+	const char* fromChars(const char* first, const char* last, TimePoint& timePoint) noexcept;
+
 	/**
 	* @brief Converts the struct to an iso string
 	*
 	* @returns std::string
 	*/
-	[[nodiscard]] inline std::string toStr(const TimePoint& timePoint) noexcept
-	{
-		const int NANO_SECOND_PRECISION = 9;
-
-		const auto timeSinceEpoch = timePoint.time_since_epoch().count();
-		const time_t secondsFromEpoch = timeSinceEpoch / Duration::period::den;
-		const auto fractionalSeconds = static_cast<double>(timeSinceEpoch % Duration::period::den) / static_cast<double>(Duration::period::den);
-
-		std::tm tm{};
-#ifdef _MSC_VER
-		gmtime_s(&tm, &secondsFromEpoch);
-#else
-		gmtime_r(&secondsFromEpoch, &tm);
-#endif
-		std::stringstream ss{};
-		if(fractionalSeconds > 0)
-		{
-			const auto format = "%Y-%m-%dT%H:%M:%S.";
-			std::stringstream ssFractionalSecond{};
-			ssFractionalSecond.precision(NANO_SECOND_PRECISION);
-			ssFractionalSecond << std::fixed << fractionalSeconds;
-			auto fractionalSecondStr = ssFractionalSecond.str();
-			// strip off the preceding "0."
-			fractionalSecondStr = fractionalSecondStr.substr(2, fractionalSecondStr.size());
-			// strip off any trailing zeros
-			fractionalSecondStr = fractionalSecondStr.substr(0, fractionalSecondStr.find_last_not_of('0') + 1);
-			const auto fractionalSecondsFormat = format + fractionalSecondStr + "Z";
-			ss << std::put_time(&tm, fractionalSecondsFormat.c_str());
-		}
-		else
-		{
-			const auto format = "%Y-%m-%dT%H:%M:%SZ";
-			ss << std::put_time(&tm, format);
-		}
-
-		return ss.str();
-	}
+	[[nodiscard]] std::string toStr(const TimePoint& timePoint) noexcept;
 
 	/**
 	 * @brief Converts a duration to a floating point number in seconds.
@@ -103,10 +94,7 @@ namespace {{ns_tpl}}
 	 * @param type: the Duration
 	 * @returns std::ostream
 	 */
-	inline std::ostream& operator<<(std::ostream& os, const Duration duration)
-	{
-		return os << duration.count() << " nanoseconds";
-	}
+	std::ostream& operator<<(std::ostream& os, const Duration duration);
 
 	/**
 	 * @brief Output stream operator for the TimePoint type
@@ -115,8 +103,5 @@ namespace {{ns_tpl}}
 	 * @param type: the TimePoint
 	 * @returns std::ostream
 	 */
-	inline std::ostream& operator<<(std::ostream& os, const TimePoint& timepoint)
-	{
-		return os << timepoint.time_since_epoch() << " nanoseconds since epoch";
-	}
+	std::ostream& operator<<(std::ostream& os, const TimePoint& timepoint);
 } // namespace {{ns_tpl}}
\ No newline at end of file
@@ -0,0 +1,86 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace {{ns_tpl}}
+{
+	/**
+	 * @brief Compile time name tables of a generated enum, specialized in each enum header
+	 * with COUNT, VALUES, NAMES, indexOf(value) and the DISPLACEMENTS/SLOTS of the perfect
+	 * hash over the names (built by the generator, see enum.perfect_hash).
+	 */
+	template <typename E>
+	class EnumTraits;
+
+	/**
+	 * @brief Seeded FNV-1a over the name with a final avalanche so the low bits used to index
+	 * the tables are well mixed. Mirrored by the generator, keep both in sync.
+	 *
+	 * @param name: the enum name
+	 * @param seed: 0 for the bucket, the bucket displacement for the slot
+	 */
+	constexpr std::uint32_t enumNameHash(std::string_view name, std::uint32_t seed) noexcept
+	{
+		std::uint32_t hash = 2166136261u ^ (seed * 0x9e3779b9u);
+		for (const char c : name)
+		{
+			hash ^= static_cast<unsigned char>(c);
+			hash *= 16777619u;
+		}
+		hash ^= hash >> 16;
+		hash *= 0x85ebca6bu;
+		hash ^= hash >> 13;
+		return hash;
+	}
+
+	/**
+	 * @brief Number of values of the enum
+	 */
+	template <typename E>
+	constexpr std::size_t enumCount() noexcept
+	{
+		return EnumTraits<E>::COUNT;
+	}
+
+	/**
+	 * @brief Every value of the enum in declaration order, for iteration
+	 */
+	template <typename E>
+	constexpr const auto& enumValues() noexcept
+	{
+		return EnumTraits<E>::VALUES;
+	}
+
+	/**
+	 * @brief Every name of the enum in declaration order
+	 */
+	template <typename E>
+	constexpr const auto& enumNames() noexcept
+	{
+		return EnumTraits<E>::NAMES;
+	}
+
+	/**
+	 * @brief Parses an enum from its name with two hashes and one comparison
+	 *
+	 * @param name: the enum name, case sensitive
+	 * @returns the value or std::nullopt if the name is not one of the enum
+	 */
+	template <typename E>
+	constexpr std::optional<E> fromString(std::string_view name) noexcept
+	{
+		using Traits = EnumTraits<E>;
+		const auto bucket = enumNameHash(name, 0) & (Traits::DISPLACEMENTS.size() - 1);
+		const auto slot = enumNameHash(name, Traits::DISPLACEMENTS[bucket]) & (Traits::SLOTS.size() - 1);
+		const std::size_t index = Traits::SLOTS[slot];
+		if (index < Traits::COUNT && Traits::NAMES[index] == name)
+		{
+			return Traits::VALUES[index];
+		}
+		return std::nullopt;
+	}
+} // namespace {{ns_tpl}}
@@ -0,0 +1,150 @@
+#include <cstring>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define ESSENTIALLY_EQUAL_AVX2 1
+#include <immintrin.h>
+#endif
+
+#include "EssentiallyEqual.h"
+
+namespace {{ns_tpl}}
+{
+	namespace essentially_equal_impl
+	{
+		/**
+		 * @brief Maps the sign and magnitude bits of a float to a signed integer with the same
+		 * order (-0.0 and +0.0 both map to 0), so the ULP distance is the integer difference.
+		 */
+		template <typename Signed>
+		constexpr Signed orderedBits(Signed bits) noexcept
+		{
+			constexpr Signed MAGNITUDE = std::numeric_limits<Signed>::max();
+			return bits < 0 ? static_cast<Signed>(-(bits & MAGNITUDE)) : bits;
+		}
+
+		/**
+		 * @brief Branch free scalar loop, the same result as gtest_clone::FloatingPoint::AlmostEquals
+		 * per element: NaNs are never equal, at most kMaxUlps apart otherwise.
+		 */
+		template <typename T>
+		bool scalarEqual(const T* values1, const T* values2, std::size_t count) noexcept
+		{
+			using Bits = typename gtest_clone::FloatingPoint<T>::Bits;
+			using Signed = std::make_signed_t<Bits>;
+			constexpr Bits MAGNITUDE = std::numeric_limits<Signed>::max();
+			constexpr Bits INFINITY_BITS = gtest_clone::FloatingPoint<T>::kExponentBitMask;
+			constexpr Bits MAX_ULPS = gtest_clone::FloatingPoint<T>::kMaxUlps;
+
+			Bits mismatches = 0;
+			for(std::size_t i = 0; i < count; ++i)
+			{
+				Signed bits1;
+				Signed bits2;
+				std::memcpy(&bits1, values1 + i, sizeof(T));
+				std::memcpy(&bits2, values2 + i, sizeof(T));
+				const Bits nan = static_cast<Bits>((static_cast<Bits>(bits1) & MAGNITUDE) > INFINITY_BITS)
+				                 | static_cast<Bits>((static_cast<Bits>(bits2) & MAGNITUDE) > INFINITY_BITS);
+				const Bits ordered1 = static_cast<Bits>(orderedBits(bits1));
+				const Bits ordered2 = static_cast<Bits>(orderedBits(bits2));
+				const Bits distance = static_cast<Signed>(ordered1) > static_cast<Signed>(ordered2) ? ordered1 - ordered2 : ordered2 - ordered1;
+				mismatches |= nan | static_cast<Bits>(distance > MAX_ULPS);
+			}
+			return mismatches == 0;
+		}
+
+#ifdef ESSENTIALLY_EQUAL_AVX2
+		/**
+		 * @brief True if the CPU running us has AVX2, checked once
+		 */
+		bool hasAvx2() noexcept
+		{
+			static const bool supported = __builtin_cpu_supports("avx2");
+			return supported;
+		}
+
+		/**
+		 * @brief 4 doubles per step, the same math as scalarEqual on 64 bit lanes. The
+		 * unsigned distance check flips the sign bits to use the signed compare.
+		 */
+		__attribute__((target("avx2"))) bool avx2Equal(const double* values1, const double* values2, std::size_t count) noexcept
+		{
+			const __m256i magnitude = _mm256_set1_epi64x(std::numeric_limits<std::int64_t>::max());
+			const __m256i infinity = _mm256_set1_epi64x(static_cast<std::int64_t>(gtest_clone::FloatingPoint<double>::kExponentBitMask));
+			const __m256i sign = _mm256_set1_epi64x(std::numeric_limits<std::int64_t>::min());
+			const __m256i maxUlps = _mm256_xor_si256(_mm256_set1_epi64x(gtest_clone::FloatingPoint<double>::kMaxUlps), sign);
+			const __m256i zero = _mm256_setzero_si256();
+
+			__m256i mismatches = zero;
+			std::size_t i = 0;
+			for(; i + 4 <= count; i += 4)
+			{
+				const __m256i bits1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values1 + i));
+				const __m256i bits2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values2 + i));
+				const __m256i abs1 = _mm256_and_si256(bits1, magnitude);
+				const __m256i abs2 = _mm256_and_si256(bits2, magnitude);
+				const __m256i nan = _mm256_or_si256(_mm256_cmpgt_epi64(abs1, infinity), _mm256_cmpgt_epi64(abs2, infinity));
+				// no 64 bit arithmetic shift in AVX2, the compare spreads the sign over the lane
+				const __m256i ordered1 = _mm256_blendv_epi8(bits1, _mm256_sub_epi64(zero, abs1), _mm256_cmpgt_epi64(zero, bits1));
+				const __m256i ordered2 = _mm256_blendv_epi8(bits2, _mm256_sub_epi64(zero, abs2), _mm256_cmpgt_epi64(zero, bits2));
+				const __m256i distance = _mm256_blendv_epi8(_mm256_sub_epi64(ordered2, ordered1), _mm256_sub_epi64(ordered1, ordered2),
+				                                            _mm256_cmpgt_epi64(ordered1, ordered2));
+				const __m256i tooFar = _mm256_cmpgt_epi64(_mm256_xor_si256(distance, sign), maxUlps);
+				mismatches = _mm256_or_si256(mismatches, _mm256_or_si256(nan, tooFar));
+			}
+			return _mm256_testz_si256(mismatches, mismatches) && scalarEqual(values1 + i, values2 + i, count - i);
+		}
+
+		/**
+		 * @brief 8 floats per step, see the double overload
+		 */
+		__attribute__((target("avx2"))) bool avx2Equal(const float* values1, const float* values2, std::size_t count) noexcept
+		{
+			const __m256i magnitude = _mm256_set1_epi32(std::numeric_limits<std::int32_t>::max());
+			const __m256i infinity = _mm256_set1_epi32(static_cast<std::int32_t>(gtest_clone::FloatingPoint<float>::kExponentBitMask));
+			const __m256i sign = _mm256_set1_epi32(std::numeric_limits<std::int32_t>::min());
+			const __m256i maxUlps = _mm256_xor_si256(_mm256_set1_epi32(gtest_clone::FloatingPoint<float>::kMaxUlps), sign);
+			const __m256i zero = _mm256_setzero_si256();
+
+			__m256i mismatches = zero;
+			std::size_t i = 0;
+			for(; i + 8 <= count; i += 8)
+			{
+				const __m256i bits1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values1 + i));
+				const __m256i bits2 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values2 + i));
+				const __m256i abs1 = _mm256_and_si256(bits1, magnitude);
+				const __m256i abs2 = _mm256_and_si256(bits2, magnitude);
+				const __m256i nan = _mm256_or_si256(_mm256_cmpgt_epi32(abs1, infinity), _mm256_cmpgt_epi32(abs2, infinity));
+				const __m256i ordered1 = _mm256_blendv_epi8(bits1, _mm256_sub_epi32(zero, abs1), _mm256_srai_epi32(bits1, 31));
+				const __m256i ordered2 = _mm256_blendv_epi8(bits2, _mm256_sub_epi32(zero, abs2), _mm256_srai_epi32(bits2, 31));
+				const __m256i distance = _mm256_blendv_epi8(_mm256_sub_epi32(ordered2, ordered1), _mm256_sub_epi32(ordered1, ordered2),
+				                                            _mm256_cmpgt_epi32(ordered1, ordered2));
+				const __m256i tooFar = _mm256_cmpgt_epi32(_mm256_xor_si256(distance, sign), maxUlps);
+				mismatches = _mm256_or_si256(mismatches, _mm256_or_si256(nan, tooFar));
+			}
+			return _mm256_testz_si256(mismatches, mismatches) && scalarEqual(values1 + i, values2 + i, count - i);
+		}
+#endif
+
+		template <typename T>
+		bool rangeEqual(const T* values1, const T* values2, std::size_t count) noexcept
+		{
+#ifdef ESSENTIALLY_EQUAL_AVX2
+			if(hasAvx2())
+			{
+				return avx2Equal(values1, values2, count);
+			}
+#endif
+			return scalarEqual(values1, values2, count);
+		}
+	} // namespace essentially_equal_impl
+
+	bool EssentiallyEqual(const double* values1, const double* values2, std::size_t count) noexcept
+	{
+		return essentially_equal_impl::rangeEqual(values1, values2, count);
+	}
+
+	bool EssentiallyEqual(const float* values1, const float* values2, std::size_t count) noexcept
+	{
+		return essentially_equal_impl::rangeEqual(values1, values2, count);
+	}
+} // namespace {{ns_tpl}}
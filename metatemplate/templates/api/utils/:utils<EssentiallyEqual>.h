@@ -2,6 +2,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <limits>
 #include <functional>
@@ -275,6 +276,19 @@ namespace {{ns_tpl}}
 		return v1.has_value() && v2.has_value() ? EssentiallyEqual(v1.value(), v2.value()) : !(v1.has_value() || v2.has_value());
 	}
 
+	/**
+	 * @brief Checks if count pairs of values are all essentially equal, with the tolerance of
+	 * the single value overload. Runs 4 doubles/8 floats at a time when the CPU has AVX2
+	 * (checked at runtime), a branch free scalar loop otherwise.
+	 *
+	 * @param values1: the first values
+	 * @param values2: the second values
+	 * @param count: number of values in each
+	 * @returns bool true if equal
+	 */
+	[[nodiscard]] bool EssentiallyEqual(const double* values1, const double* values2, std::size_t count) noexcept;
+	[[nodiscard]] bool EssentiallyEqual(const float* values1, const float* values2, std::size_t count) noexcept;
+
     /**
      * @brief Checks if two optional floating point vectors are essentially equal
      *
@@ -285,8 +299,15 @@ namespace {{ns_tpl}}
     template <typename T, std::enable_if_t<std::is_floating_point<T>::value, int> = 0>
     [[nodiscard]] bool EssentiallyEqual(const std::vector<T>& vec1, const std::vector<T>& vec2) noexcept
     {
+        if constexpr (std::is_same_v<T, double> || std::is_same_v<T, float>)
+        {
+            return vec1.size() == vec2.size() && EssentiallyEqual(vec1.data(), vec2.data(), vec1.size());
+        }
+        else
+        {
             return vec1.size() == vec2.size()
                        && std::equal(vec1.begin(), vec1.end(), vec2.begin(), vec2.end(),
                                                      [](const auto& v1, const auto& v2) { return EssentiallyEqual(v1, v2); });
+        }
     }
 } // namespace {{ns_tpl}}
\ No newline at end of file
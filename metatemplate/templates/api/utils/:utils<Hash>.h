@@ -0,0 +1,172 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "UUID.h"
+
+namespace {{ns_tpl}}
+{
+	/**
+	 * @brief Mixes a value hash into a seed (boost::hash_combine with a 64 bit constant)
+	 *
+	 * @param seed: the running hash
+	 * @param value: the hash to combine
+	 */
+	inline void hashCombine(std::size_t& seed, std::size_t value) noexcept
+	{
+		seed ^= value + static_cast<std::size_t>(0x9e3779b97f4a7c15ULL) + (seed << 6) + (seed >> 2);
+	}
+
+	/**
+	 * @brief Hash functor used by the generated types for their fields, specialized below
+	 * for the containers and util types used as members. Defaults to std::hash.
+	 *
+	 * @note class templates rather than hashValue overloads so nested containers resolve
+	 * regardless of declaration order.
+	 */
+	template <typename T, typename = void>
+	class Hasher
+	{
+	public:
+		std::size_t operator()(const T& value) const noexcept
+		{
+			return std::hash<T>{}(value);
+		}
+	};
+
+	/**
+	 * @brief Hash a value with the Hasher for its type
+	 *
+	 * @param value: the value to hash
+	 * @returns std::size_t
+	 */
+	template <typename T>
+	[[nodiscard]] std::size_t hashValue(const T& value) noexcept
+	{
+		return Hasher<T>{}(value);
+	}
+
+	/**
+	 * @brief Floating point values don't contribute to a hash, generated equality is ULP
+	 * tolerant (see EssentiallyEqual.h) and no hash of the value could be consistent with it.
+	 */
+	template <typename T>
+	class Hasher<T, std::enable_if_t<std::is_floating_point_v<T>>>
+	{
+	public:
+		std::size_t operator()(T) const noexcept
+		{
+			return 0;
+		}
+	};
+
+	/**
+	 * @brief Generated types (struct/variant/alias) provide their own hash()
+	 */
+	template <typename T>
+	class Hasher<T, std::void_t<decltype(std::declval<const T&>().hash())>>
+	{
+	public:
+		std::size_t operator()(const T& value) const noexcept
+		{
+			return value.hash();
+		}
+	};
+
+	template <>
+	class Hasher<UUID>
+	{
+	public:
+		std::size_t operator()(const UUID& value) const noexcept
+		{
+			return UUIDHash{}(value);
+		}
+	};
+
+	template <typename Rep, typename Period>
+	class Hasher<std::chrono::duration<Rep, Period>>
+	{
+	public:
+		std::size_t operator()(const std::chrono::duration<Rep, Period>& value) const noexcept
+		{
+			return hashValue(value.count());
+		}
+	};
+
+	template <typename ClockType, typename DurationType>
+	class Hasher<std::chrono::time_point<ClockType, DurationType>>
+	{
+	public:
+		std::size_t operator()(const std::chrono::time_point<ClockType, DurationType>& value) const noexcept
+		{
+			return hashValue(value.time_since_epoch());
+		}
+	};
+
+	template <typename T>
+	class Hasher<std::optional<T>>
+	{
+	public:
+		std::size_t operator()(const std::optional<T>& value) const noexcept
+		{
+			std::size_t seed = value.has_value();
+			if(value)
+			{
+				hashCombine(seed, hashValue(*value));
+			}
+			return seed;
+		}
+	};
+
+	template <typename T, typename Allocator>
+	class Hasher<std::vector<T, Allocator>>
+	{
+	public:
+		std::size_t operator()(const std::vector<T, Allocator>& values) const noexcept
+		{
+			std::size_t seed = values.size();
+			for(const auto& value : values)
+			{
+				hashCombine(seed, hashValue(static_cast<const T&>(value)));
+			}
+			return seed;
+		}
+	};
+
+	template <typename... T>
+	class Hasher<std::variant<T...>>
+	{
+	public:
+		std::size_t operator()(const std::variant<T...>& value) const noexcept
+		{
+			std::size_t seed = value.index();
+			if(!value.valueless_by_exception())
+			{
+				hashCombine(seed, std::visit([](const auto& held) { return hashValue(held); }, value));
+			}
+			return seed;
+		}
+	};
+
+	/**
+	 * @brief Polymorphic (shared_ptr) members compare by pointer, so they hash by pointer.
+	 */
+	template <typename T>
+	class Hasher<std::shared_ptr<T>>
+	{
+	public:
+		std::size_t operator()(const std::shared_ptr<T>& value) const noexcept
+		{
+			return std::hash<const T*>{}(value.get());
+		}
+	};
+} // namespace {{ns_tpl}}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace {{ns_tpl}}
+{
+	/**
+	 * @brief Matcher for a pattern restriction compiled by the generator into a minimal DFA
+	 * over the UTF-8 bytes of the value (overrides/dfa.py), the whole value has to match.
+	 *
+	 * @tparam State: smallest unsigned type holding STATE_COUNT
+	 * @tparam CLASS_COUNT: number of byte classes, the columns of the transition table
+	 * @tparam STATE_COUNT: number of states, 0 is the dead state and 1 the start
+	 */
+	template <typename State, std::size_t CLASS_COUNT, std::size_t STATE_COUNT>
+	class PatternDfa
+	{
+	public:
+		/// byte -> column of the transition table
+		std::array<std::uint8_t, 256> classes;
+		/// next state at state * CLASS_COUNT + class
+		std::array<State, STATE_COUNT * CLASS_COUNT> transitions;
+		std::array<bool, STATE_COUNT> accepting;
+
+		/**
+		 * @brief Runs the value through the tables, stops at the first byte that cannot match
+		 *
+		 * @param value: the value to check
+		 * @returns true if the whole value matches the pattern
+		 */
+		constexpr bool matches(std::string_view value) const noexcept
+		{
+			std::size_t state = 1;
+			for (const char c : value)
+			{
+				state = transitions[state * CLASS_COUNT + classes[static_cast<unsigned char>(c)]];
+				if (state == 0)
+				{
+					return false;
+				}
+			}
+			return accepting[state];
+		}
+	};
+} // namespace {{ns_tpl}}
@@ -1,8 +1,8 @@
 #pragma once
 
 #include <algorithm>
-#include <iostream>
 #include <optional>
+#include <ostream>
 #include <string>
 #include <variant>
 #include <vector>
@@ -0,0 +1,223 @@
+#include <cerrno>
+#include <random>
+#include <stdexcept>
+#include <string_view>
+#include <system_error>
+
+#if defined(__linux__)
+#include <sys/random.h>
+#endif
+#if defined(__unix__) || defined(__APPLE__)
+#include <pthread.h>
+#endif
+
+#include "UUID.h"
+
+namespace {{ns_tpl}}
+{
+	namespace uuid_impl
+	{
+		constexpr std::uint8_t NOT_HEX = 0xff;
+
+		/**
+		 * @brief Byte to two lower case hex characters, and hex character to nibble
+		 */
+		struct HexTables
+		{
+			char encode[256 * 2];
+			std::uint8_t decode[256];
+
+			constexpr HexTables() : encode{}, decode{}
+			{
+				constexpr char DIGITS[] = "0123456789abcdef";
+				for(unsigned i = 0; i < 256; ++i)
+				{
+					encode[i * 2] = DIGITS[i >> 4];
+					encode[i * 2 + 1] = DIGITS[i & 0xf];
+					decode[i] = NOT_HEX;
+				}
+				for(unsigned i = 0; i < 10; ++i)
+				{
+					decode['0' + i] = static_cast<std::uint8_t>(i);
+				}
+				for(unsigned i = 0; i < 6; ++i)
+				{
+					decode['a' + i] = static_cast<std::uint8_t>(10 + i);
+					decode['A' + i] = static_cast<std::uint8_t>(10 + i);
+				}
+			}
+		};
+
+		constexpr HexTables HEX{};
+
+		/**
+		 * @brief The bytes after which a '-' is written
+		 */
+		constexpr bool dashAfter(std::size_t byte) noexcept
+		{
+			return byte == 3 || byte == 5 || byte == 7 || byte == 9;
+		}
+
+		/**
+		 * @brief Parses the 32 hex digits of a UUID, with the 8-4-4-4-12 dashes if dashed.
+		 * The caller checks the length (UUID_CHARS, or UUID_CHARS - 4 without dashes).
+		 *
+		 * @returns one past the last character parsed, or nullptr (id is then unchanged)
+		 */
+		const char* parseHex(const char* first, UUID& id, bool dashed) noexcept
+		{
+			UUID parsed;
+			// or the nibbles together and check once, only a non hex character sets the high bits
+			std::uint8_t invalid = 0;
+			for(std::size_t byte = 0; byte < sizeof(parsed.data); ++byte)
+			{
+				const auto high = HEX.decode[static_cast<unsigned char>(first[0])];
+				const auto low = HEX.decode[static_cast<unsigned char>(first[1])];
+				invalid |= high | low;
+				parsed.data[byte] = static_cast<std::uint8_t>((high << 4) | (low & 0xf));
+				first += 2;
+				if(dashed && dashAfter(byte))
+				{
+					invalid |= *first++ == '-' ? 0 : NOT_HEX;
+				}
+			}
+			if(invalid & 0xf0)
+			{
+				return nullptr;
+			}
+			id = parsed;
+			return first;
+		}
+
+		/**
+		 * @brief Per thread block of OS entropy. One refill covers 64 UUIDs, which amortizes the
+		 * system call. The block is emptied in the child after fork(), so parent and child never
+		 * hand out the same bytes.
+		 */
+		class EntropyBuffer
+		{
+		public:
+			static constexpr std::size_t SIZE = 64 * sizeof(UUID);
+
+			void take(UUID& id)
+			{
+				if(position_ == SIZE)
+				{
+					refill();
+				}
+				std::memcpy(&id, bytes_ + position_, sizeof(id));
+				position_ += sizeof(id);
+			}
+
+			void discard() noexcept
+			{
+				position_ = SIZE;
+			}
+
+		private:
+			void refill();
+
+			std::uint8_t bytes_[SIZE];
+			std::size_t position_ = SIZE;
+		};
+
+		thread_local EntropyBuffer entropy;
+
+		void EntropyBuffer::refill()
+		{
+#if defined(__unix__) || defined(__APPLE__)
+			// only the forking thread survives in the child, its block is the one to drop
+			static const int atfork = pthread_atfork(nullptr, nullptr, [] { entropy.discard(); });
+			if(atfork != 0)
+			{
+				throw std::system_error(atfork, std::generic_category(), "GenerateUUID: pthread_atfork");
+			}
+#endif
+#if defined(__linux__)
+			std::size_t filled = 0;
+			while(filled < SIZE)
+			{
+				const auto read = getrandom(bytes_ + filled, SIZE - filled, 0);
+				if(read < 0)
+				{
+					if(errno == EINTR)
+					{
+						continue;
+					}
+					throw std::system_error(errno, std::generic_category(), "GenerateUUID: getrandom");
+				}
+				filled += static_cast<std::size_t>(read);
+			}
+#else
+			std::random_device device;
+			for(std::size_t i = 0; i < SIZE; i += sizeof(std::random_device::result_type))
+			{
+				const auto word = device();
+				std::memcpy(bytes_ + i, &word, sizeof(word));
+			}
+#endif
+			position_ = 0;
+		}
+	} // namespace uuid_impl
+
+	UUID GenerateUUID()
+	{
+		UUID id;
+		uuid_impl::entropy.take(id);
+		// version 4, variant 1 (RFC 4122)
+		id.data[6] = static_cast<std::uint8_t>((id.data[6] & 0x0f) | 0x40);
+		id.data[8] = static_cast<std::uint8_t>((id.data[8] & 0x3f) | 0x80);
+		return id;
+	}
+
+	char* UUIDtoChars(const UUID& id, char* out) noexcept
+	{
+		for(std::size_t byte = 0; byte < sizeof(id.data); ++byte)
+		{
+			std::memcpy(out, uuid_impl::HEX.encode + id.data[byte] * 2, 2);
+			out += 2;
+			if(uuid_impl::dashAfter(byte))
+			{
+				*out++ = '-';
+			}
+		}
+		return out;
+	}
+
+	const char* UUIDfromChars(const char* first, const char* last, UUID& id) noexcept
+	{
+		if(last - first < static_cast<std::ptrdiff_t>(UUID_CHARS))
+		{
+			return nullptr;
+		}
+		return uuid_impl::parseHex(first, id, true);
+	}
+
+	std::string UUIDtoStr(const UUID& id)
+	{
+		char chars[UUID_CHARS];
+		return std::string(chars, UUIDtoChars(id, chars));
+	}
+
+	UUID UUIDfromStr(const std::string& id)
+	{
+		// the forms boost::uuids::string_generator accepted: optional braces, dashes or none
+		std::string_view text(id);
+		if(text.size() >= 2 && text.front() == '{' && text.back() == '}')
+		{
+			text = text.substr(1, text.size() - 2);
+		}
+		const bool dashed = text.size() == UUID_CHARS;
+		if(!dashed && text.size() != UUID_CHARS - 4)
+		{
+			throw std::invalid_argument("UUIDfromStr: '" + id + "' is not a UUID");
+		}
+		UUID parsed;
+		if(uuid_impl::parseHex(text.data(), parsed, dashed) != text.data() + text.size())
+		{
+			throw std::invalid_argument("UUIDfromStr: '" + id + "' is not a UUID");
+		}
+		return parsed;
+	}
+
+} // namespace {{ns_tpl}}
@@ -1,9 +1,11 @@
 #pragma once
 
-#include <boost/lexical_cast.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
 #include <boost/uuid/uuid.hpp>
-#include <boost/uuid/uuid_generators.hpp>
-#include <boost/uuid/uuid_io.hpp>
 
 namespace {{ns_tpl}}
 {
@@ -13,16 +15,37 @@ namespace {{ns_tpl}}
 	using UUID = boost::uuids::uuid;
 
 	/**
-	 * @brief Generates a random UUID
+	 * @brief The characters in a UUID string, "xxxxxxxx-xxxx-xxxx-xxxx-xxxxxxxxxxxx"
+	 */
+	inline constexpr std::size_t UUID_CHARS = 36;
+
+	/**
+	 * @brief Generates a random (version 4) UUID from OS entropy (getrandom, std::random_device
+	 * elsewhere), read in per thread blocks that are dropped in the child after fork().
 	 *
 	 * @returns UUID
 	 */
+	[[nodiscard]] UUID GenerateUUID();
 
-	[[nodiscard]] inline UUID GenerateUUID()
+	/**
+	 * @brief Writes the UUID as lower case hex in the 8-4-4-4-12 form
+	 *
+	 * @param id: the uuid to write
+	 * @param out: the output, at least UUID_CHARS long, not null terminated
+	 * @returns char* one past the last character written
+	 */
+	char* UUIDtoChars(const UUID& id, char* out) noexcept;
 
-	{
-		return boost::uuids::random_generator()();
-	}
+	/**
+	 * @brief Parses a UUID in the 8-4-4-4-12 form, hex digits of either case
+	 *
+	 * @param first: the start of the string
+	 * @param last: the end of the string
+	 * @param id: set to the parsed uuid on success
+	 * @returns const char* one past the last character parsed, or nullptr if the string
+	 * does not start with a UUID (id is then unchanged)
+	 */
+	const char* UUIDfromChars(const char* first, const char* last, UUID& id) noexcept;
 
 	/**
 	 * @brief Converts the UUID type to a string
@@ -30,36 +53,45 @@ namespace {{ns_tpl}}
 	 * @param id: the uuid to convert
 	 * @returns std::string
 	 */
-
-	[[nodiscard]] inline std::string UUIDtoStr(const UUID& id)
-
-	{
-		return boost::lexical_cast<std::string>(id);
-	}
+	[[nodiscard]] std::string UUIDtoStr(const UUID& id);
 
 	/**
-	 * @brief Converts the string to a UUID type
+	 * @brief Converts the string to a UUID type, accepts the 8-4-4-4-12 form, the 32 hex
+	 * digits without dashes and either of them in braces
 	 *
 	 * @param id: the uuid to convert
+	 * @throws std::invalid_argument if the string is not a UUID
 	 * @returns UUID
 	 */
-
-	[[nodiscard]] inline UUID UUIDfromStr(const std::string& id)
-
-	{
-		return boost::lexical_cast<UUID>(id);
-	}
+	[[nodiscard]] UUID UUIDfromStr(const std::string& id);
 
 	/**
 	 * @brief Generates a random UUID string
 	 *
 	 * @returns string
 	 */
-
 	[[nodiscard]] inline std::string GenerateUUIDStr()
-
 	{
 		return UUIDtoStr(GenerateUUID());
 	}
 
-} // namespace {{ns_tpl}}
\ No newline at end of file
+	/**
+	 * @brief Hash functor for UUID keyed containers, the UUID bytes are already random so
+	 * the two halves are folded together with a multiply to spread the sequential ones.
+	 */
+	class UUIDHash
+	{
+	public:
+		std::size_t operator()(const UUID& id) const noexcept
+		{
+			std::uint64_t high;
+			std::uint64_t low;
+			std::memcpy(&high, id.data, sizeof(high));
+			std::memcpy(&low, id.data + sizeof(high), sizeof(low));
+			auto hash = high ^ (low * 0x9e3779b97f4a7c15ULL);
+			hash = (hash ^ (hash >> 32)) * 0xbf58476d1ce4e5b9ULL;
+			return static_cast<std::size_t>(hash ^ (hash >> 31));
+		}
+	};
+
+} // namespace {{ns_tpl}}
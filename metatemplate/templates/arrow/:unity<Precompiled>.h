@@ -0,0 +1,13 @@
+#pragma once
+
+// Precompiled header for the {{ns_package}} library, only the stable
+// std headers and the column builders shared by every builder belong here.
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "{{path_package}}/builders/Columns.h"
@@ -0,0 +1,799 @@
+{%- set ns_base = ns_utils if ns_utils else ns_api -%}
+{%- set path_base = path_utils if ns_utils else path_api -%}
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "{{path_package}}/builders/ArrowC.h"
+#include "{{path_base}}/byte_stream/ByteStream.h"
+#include "{{path_base}}/utils/Clock.h"
+#include "{{path_base}}/utils/UUID.h"
+
+// Columnar (Arrow layout) builders for the {{ns_api}} types. Each builder appends values
+// into contiguous per field buffers, exportTo() hands them over zero-copy through the
+// Arrow C data interface (e.g. pyarrow.Array._import_from_c) and leaves the builder empty.
+//
+// Every builder provides:
+//   using value_type
+//   void reserve(std::size_t count)
+//   void append(const value_type& value)
+//   void appendNull()
+//   std::size_t size() const
+//   void exportTo(ArrowArray* array, ArrowSchema* schema, const char* name, bool nullable)
+namespace {{ns_tpl}}
+{
+	namespace byte_stream = {{ns_base}}::byte_stream;
+	namespace utils = {{ns_base}}::utils;
+
+	namespace builders_impl
+	{
+		/**
+		 * @brief private_data of an exported ArrowArray, owns the buffers and the children
+		 */
+		struct ArrayData
+		{
+			std::vector<std::shared_ptr<void>> owners;
+			std::vector<const void*> buffers;
+			std::vector<ArrowArray> children;
+			std::vector<ArrowArray*> childPointers;
+
+			~ArrayData()
+			{
+				// children moved out by the consumer have release cleared
+				for(auto& child : children)
+				{
+					if(child.release)
+					{
+						child.release(&child);
+					}
+				}
+			}
+		};
+
+		/**
+		 * @brief private_data of an exported ArrowSchema, owns the strings and the children
+		 */
+		struct SchemaData
+		{
+			std::string format;
+			std::string name;
+			std::vector<ArrowSchema> children;
+			std::vector<ArrowSchema*> childPointers;
+
+			~SchemaData()
+			{
+				for(auto& child : children)
+				{
+					if(child.release)
+					{
+						child.release(&child);
+					}
+				}
+			}
+		};
+
+		inline void releaseArray(ArrowArray* array)
+		{
+			delete static_cast<ArrayData*>(array->private_data);
+			array->release = nullptr;
+		}
+
+		inline void releaseSchema(ArrowSchema* schema)
+		{
+			delete static_cast<SchemaData*>(schema->private_data);
+			schema->release = nullptr;
+		}
+
+		/**
+		 * @brief Arrow offsets are signed, checks a buffer position still fits
+		 */
+		template <typename Offset>
+		[[nodiscard]] Offset toOffset(std::size_t position)
+		{
+			if(position > static_cast<std::size_t>(std::numeric_limits<Offset>::max()))
+			{
+				throw std::length_error("arrow column exceeds the offset range");
+			}
+			return static_cast<Offset>(position);
+		}
+	} // namespace builders_impl
+
+	/**
+	 * @brief Assembles one exported array/schema node. Children are exported into
+	 * childArray(i)/childSchema(i), finish() hands the node over to the consumer.
+	 * A node dropped before finish() releases everything exported so far.
+	 */
+	class ArrayExport
+	{
+	public:
+		ArrayExport(std::string format, std::size_t children) :
+			array_(std::make_unique<builders_impl::ArrayData>()), schema_(std::make_unique<builders_impl::SchemaData>())
+		{
+			schema_->format = std::move(format);
+			array_->children.resize(children);
+			schema_->children.resize(children);
+			for(std::size_t i = 0; i < children; ++i)
+			{
+				array_->childPointers.push_back(&array_->children[i]);
+				schema_->childPointers.push_back(&schema_->children[i]);
+			}
+		}
+
+		/**
+		 * @brief An absent buffer, e.g. the validity bitmap of a column without nulls
+		 */
+		void addBuffer(std::nullptr_t)
+		{
+			array_->buffers.push_back(nullptr);
+		}
+
+		/**
+		 * @brief Takes ownership of the values, the data is not copied
+		 */
+		template <typename T>
+		void addBuffer(std::vector<T>&& values)
+		{
+			auto owner = std::make_shared<std::vector<T>>(std::move(values));
+			array_->buffers.push_back(owner->empty() ? nullptr : owner->data());
+			array_->owners.push_back(std::move(owner));
+		}
+
+		[[nodiscard]] ArrowArray* childArray(std::size_t i)
+		{
+			return &array_->children[i];
+		}
+
+		[[nodiscard]] ArrowSchema* childSchema(std::size_t i)
+		{
+			return &schema_->children[i];
+		}
+
+		void finish(ArrowArray* array, ArrowSchema* schema, const char* name, bool nullable, std::size_t length, std::size_t nullCount)
+		{
+			schema_->name = name;
+			const auto children = static_cast<std::int64_t>(array_->children.size());
+
+			auto* schemaData = schema_.get();
+			*schema = ArrowSchema{ schemaData->format.c_str(),
+				schemaData->name.c_str(),
+				nullptr,
+				nullable ? ARROW_FLAG_NULLABLE : 0,
+				children,
+				children ? schemaData->childPointers.data() : nullptr,
+				nullptr,
+				&builders_impl::releaseSchema,
+				schema_.release() };
+
+			auto* arrayData = array_.get();
+			*array = ArrowArray{ static_cast<std::int64_t>(length),
+				static_cast<std::int64_t>(nullCount),
+				0,
+				static_cast<std::int64_t>(arrayData->buffers.size()),
+				children,
+				arrayData->buffers.data(),
+				children ? arrayData->childPointers.data() : nullptr,
+				nullptr,
+				&builders_impl::releaseArray,
+				array_.release() };
+		}
+
+	private:
+		std::unique_ptr<builders_impl::ArrayData> array_;
+		std::unique_ptr<builders_impl::SchemaData> schema_;
+	};
+
+	/**
+	 * @brief Bit packed booleans, least significant bit first
+	 */
+	class Bitmap
+	{
+	public:
+		void reserve(std::size_t count)
+		{
+			bytes_.reserve((count + 7) / 8);
+		}
+
+		void append(bool bit)
+		{
+			if((size_ & 7) == 0)
+			{
+				bytes_.push_back(0);
+			}
+			if(bit)
+			{
+				bytes_.back() |= static_cast<std::uint8_t>(1u << (size_ & 7));
+			}
+			++size_;
+		}
+
+		[[nodiscard]] std::size_t size() const noexcept
+		{
+			return size_;
+		}
+
+		[[nodiscard]] std::vector<std::uint8_t> release() noexcept
+		{
+			auto bytes = std::move(bytes_);
+			bytes_.clear();
+			size_ = 0;
+			return bytes;
+		}
+
+	private:
+		std::vector<std::uint8_t> bytes_;
+		std::size_t size_ = 0;
+	};
+
+	/**
+	 * @brief Validity bitmap of a column, only exported once a null was appended
+	 */
+	class Validity
+	{
+	public:
+		void reserve(std::size_t count)
+		{
+			bits_.reserve(count);
+		}
+
+		void append(bool valid)
+		{
+			bits_.append(valid);
+			nullCount_ += valid ? 0 : 1;
+		}
+
+		[[nodiscard]] std::size_t nullCount() const noexcept
+		{
+			return nullCount_;
+		}
+
+		/**
+		 * @brief Adds the bitmap as the first buffer of the node and resets
+		 */
+		void exportTo(ArrayExport& node)
+		{
+			auto bits = bits_.release();
+			if(nullCount_ == 0)
+			{
+				node.addBuffer(nullptr);
+			}
+			else
+			{
+				node.addBuffer(std::move(bits));
+			}
+			nullCount_ = 0;
+		}
+
+	private:
+		Bitmap bits_;
+		std::size_t nullCount_ = 0;
+	};
+
+	/**
+	 * @brief The builder type of the values of type T
+	 */
+	template <typename T, typename = void>
+	class ColumnOf
+	{
+	};
+
+	template <typename T>
+	using ColumnOf_t = typename ColumnOf<T>::type;
+
+	/**
+	 * @brief Storage and Arrow format of the fixed width values
+	 */
+	template <typename T, typename = void>
+	class Primitive : public std::false_type
+	{
+	};
+
+#define METATEMPLATE_ARROW_PRIMITIVE(TYPE, ARROW_FORMAT)    \
+	template <>                                              \
+	class Primitive<TYPE> : public std::true_type            \
+	{                                                        \
+	public:                                                  \
+		using storage_type = TYPE;                           \
+		static constexpr const char* FORMAT = ARROW_FORMAT;  \
+		static storage_type store(TYPE value) noexcept       \
+		{                                                    \
+			return value;                                    \
+		}                                                    \
+	};
+
+	METATEMPLATE_ARROW_PRIMITIVE(std::int8_t, "c")
+	METATEMPLATE_ARROW_PRIMITIVE(std::uint8_t, "C")
+	METATEMPLATE_ARROW_PRIMITIVE(std::int16_t, "s")
+	METATEMPLATE_ARROW_PRIMITIVE(std::uint16_t, "S")
+	METATEMPLATE_ARROW_PRIMITIVE(std::int32_t, "i")
+	METATEMPLATE_ARROW_PRIMITIVE(std::uint32_t, "I")
+	METATEMPLATE_ARROW_PRIMITIVE(std::int64_t, "l")
+	METATEMPLATE_ARROW_PRIMITIVE(std::uint64_t, "L")
+	METATEMPLATE_ARROW_PRIMITIVE(float, "f")
+	METATEMPLATE_ARROW_PRIMITIVE(double, "g")
+#undef METATEMPLATE_ARROW_PRIMITIVE
+
+	// enums are stored as their underlying integer
+	template <typename T>
+	class Primitive<T, std::enable_if_t<std::is_enum_v<T>>> : public std::true_type
+	{
+	public:
+		using storage_type = std::underlying_type_t<T>;
+		static constexpr const char* FORMAT = Primitive<storage_type>::FORMAT;
+		static storage_type store(T value) noexcept
+		{
+			return static_cast<storage_type>(value);
+		}
+	};
+
+	template <>
+	class Primitive<utils::Duration> : public std::true_type
+	{
+	public:
+		using storage_type = std::int64_t;
+		static constexpr const char* FORMAT = "tDn";
+		static storage_type store(const utils::Duration& value) noexcept
+		{
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(value).count();
+		}
+	};
+
+	template <>
+	class Primitive<utils::TimePoint> : public std::true_type
+	{
+	public:
+		using storage_type = std::int64_t;
+		static constexpr const char* FORMAT = "tsn:UTC";
+		static storage_type store(const utils::TimePoint& value) noexcept
+		{
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(value.time_since_epoch()).count();
+		}
+	};
+
+	/**
+	 * @brief Fixed width values (numbers, enums, durations, time points)
+	 */
+	template <typename T>
+	class PrimitiveColumn
+	{
+	public:
+		using value_type = T;
+
+		void reserve(std::size_t count)
+		{
+			values_.reserve(count);
+			validity_.reserve(count);
+		}
+
+		void append(const value_type& value)
+		{
+			values_.push_back(Primitive<T>::store(value));
+			validity_.append(true);
+		}
+
+		void appendNull()
+		{
+			values_.emplace_back();
+			validity_.append(false);
+		}
+
+		[[nodiscard]] std::size_t size() const noexcept
+		{
+			return values_.size();
+		}
+
+		void exportTo(ArrowArray* array, ArrowSchema* schema, const char* name, bool nullable)
+		{
+			const auto length = values_.size();
+			const auto nullCount = validity_.nullCount();
+			ArrayExport node(Primitive<T>::FORMAT, 0);
+			validity_.exportTo(node);
+			node.addBuffer(std::move(values_));
+			values_.clear();
+			node.finish(array, schema, name, nullable, length, nullCount);
+		}
+
+	private:
+		std::vector<typename Primitive<T>::storage_type> values_;
+		Validity validity_;
+	};
+
+	template <typename T>
+	class ColumnOf<T, std::enable_if_t<Primitive<T>::value>>
+	{
+	public:
+		using type = PrimitiveColumn<T>;
+	};
+
+	/**
+	 * @brief Booleans, bit packed
+	 */
+	class BoolColumn
+	{
+	public:
+		using value_type = bool;
+
+		void reserve(std::size_t count)
+		{
+			values_.reserve(count);
+			validity_.reserve(count);
+		}
+
+		void append(bool value)
+		{
+			values_.append(value);
+			validity_.append(true);
+		}
+
+		void appendNull()
+		{
+			values_.append(false);
+			validity_.append(false);
+		}
+
+		[[nodiscard]] std::size_t size() const noexcept
+		{
+			return values_.size();
+		}
+
+		void exportTo(ArrowArray* array, ArrowSchema* schema, const char* name, bool nullable)
+		{
+			const auto length = values_.size();
+			const auto nullCount = validity_.nullCount();
+			ArrayExport node("b", 0);
+			validity_.exportTo(node);
+			node.addBuffer(values_.release());
+			node.finish(array, schema, name, nullable, length, nullCount);
+		}
+
+	private:
+		Bitmap values_;
+		Validity validity_;
+	};
+
+	template <>
+	class ColumnOf<bool>
+	{
+	public:
+		using type = BoolColumn;
+	};
+
+	/**
+	 * @brief Variable length bytes, large (64 bit offset) utf8 "U" or binary "Z"
+	 */
+	template <typename T, bool UTF8>
+	class VarBinaryColumn
+	{
+	public:
+		using value_type = T;
+
+		VarBinaryColumn() : offsets_{ 0 }
+		{
+		}
+
+		void reserve(std::size_t count)
+		{
+			offsets_.reserve(count + 1);
+			validity_.reserve(count);
+		}
+
+		/**
+		 * @brief Appends the raw bytes of one value
+		 */
+		void appendBytes(const void* data, std::size_t size)
+		{
+			const auto* bytes = static_cast<const std::uint8_t*>(data);
+			data_.insert(data_.end(), bytes, bytes + size);
+			offsets_.push_back(builders_impl::toOffset<std::int64_t>(data_.size()));
+			validity_.append(true);
+		}
+
+		void append(const value_type& value)
+		{
+			if constexpr(UTF8)
+			{
+				appendBytes(value.data(), value.size());
+			}
+			else
+			{
+				byte_stream::OByteStream bs;
+				bs << value;
+				appendBytes(bs.buffer().data(), bs.size());
+			}
+		}
+
+		void appendNull()
+		{
+			offsets_.push_back(offsets_.back());
+			validity_.append(false);
+		}
+
+		[[nodiscard]] std::size_t size() const noexcept
+		{
+			return offsets_.size() - 1;
+		}
+
+		void exportTo(ArrowArray* array, ArrowSchema* schema, const char* name, bool nullable)
+		{
+			const auto length = size();
+			const auto nullCount = validity_.nullCount();
+			ArrayExport node(UTF8 ? "U" : "Z", 0);
+			validity_.exportTo(node);
+			node.addBuffer(std::move(offsets_));
+			node.addBuffer(std::move(data_));
+			offsets_.assign(1, 0);
+			data_.clear();
+			node.finish(array, schema, name, nullable, length, nullCount);
+		}
+
+	private:
+		std::vector<std::int64_t> offsets_;
+		std::vector<std::uint8_t> data_;
+		Validity validity_;
+	};
+
+	using StringColumn = VarBinaryColumn<std::string, true>;
+
+	template <>
+	class ColumnOf<std::string>
+	{
+	public:
+		using type = StringColumn;
+	};
+
+	// abstract (polymorphic) members have no fixed layout, each value is its byte stream encoding
+	template <typename T>
+	class ColumnOf<std::shared_ptr<T>>
+	{
+	public:
+		class type : public VarBinaryColumn<std::shared_ptr<T>, false>
+		{
+		public:
+			void append(const std::shared_ptr<T>& value)
+			{
+				if(value)
+				{
+					VarBinaryColumn<std::shared_ptr<T>, false>::append(value);
+				}
+				else
+				{
+					this->appendNull();
+				}
+			}
+		};
+	};
+
+	/**
+	 * @brief UUIDs as fixed size binary(16)
+	 */
+	class UUIDColumn
+	{
+	public:
+		using value_type = utils::UUID;
+		static constexpr std::size_t WIDTH = sizeof(utils::UUID);
+
+		void reserve(std::size_t count)
+		{
+			data_.reserve(count * WIDTH);
+			validity_.reserve(count);
+		}
+
+		void append(const value_type& value)
+		{
+			const auto* bytes = reinterpret_cast<const std::uint8_t*>(&value);
+			data_.insert(data_.end(), bytes, bytes + WIDTH);
+			validity_.append(true);
+		}
+
+		void appendNull()
+		{
+			data_.resize(data_.size() + WIDTH);
+			validity_.append(false);
+		}
+
+		[[nodiscard]] std::size_t size() const noexcept
+		{
+			return data_.size() / WIDTH;
+		}
+
+		void exportTo(ArrowArray* array, ArrowSchema* schema, const char* name, bool nullable)
+		{
+			const auto length = size();
+			const auto nullCount = validity_.nullCount();
+			ArrayExport node("w:" + std::to_string(WIDTH), 0);
+			validity_.exportTo(node);
+			node.addBuffer(std::move(data_));
+			data_.clear();
+			node.finish(array, schema, name, nullable, length, nullCount);
+		}
+
+	private:
+		std::vector<std::uint8_t> data_;
+		Validity validity_;
+	};
+
+	template <>
+	class ColumnOf<utils::UUID>
+	{
+	public:
+		using type = UUIDColumn;
+	};
+
+	/**
+	 * @brief Optional values, a missing value is a null of the value column
+	 */
+	template <typename T>
+	class OptionalColumn
+	{
+	public:
+		using value_type = std::optional<T>;
+
+		void reserve(std::size_t count)
+		{
+			values_.reserve(count);
+		}
+
+		void append(const value_type& value)
+		{
+			if(value)
+			{
+				values_.append(*value);
+			}
+			else
+			{
+				values_.appendNull();
+			}
+		}
+
+		void appendNull()
+		{
+			values_.appendNull();
+		}
+
+		[[nodiscard]] std::size_t size() const noexcept
+		{
+			return values_.size();
+		}
+
+		void exportTo(ArrowArray* array, ArrowSchema* schema, const char* name, bool)
+		{
+			values_.exportTo(array, schema, name, true);
+		}
+
+	private:
+		ColumnOf_t<T> values_;
+	};
+
+	template <typename T>
+	class ColumnOf<std::optional<T>>
+	{
+	public:
+		using type = OptionalColumn<T>;
+	};
+
+	/**
+	 * @brief Lists as large list "+L", 64 bit offsets into one child column
+	 */
+	template <typename T>
+	class ListColumn
+	{
+	public:
+		using value_type = std::vector<T>;
+
+		ListColumn() : offsets_{ 0 }
+		{
+		}
+
+		void reserve(std::size_t count)
+		{
+			offsets_.reserve(count + 1);
+			validity_.reserve(count);
+		}
+
+		void append(const value_type& values)
+		{
+			items_.reserve(items_.size() + values.size());
+			for(const auto& value : values)
+			{
+				items_.append(value);
+			}
+			offsets_.push_back(builders_impl::toOffset<std::int64_t>(items_.size()));
+			validity_.append(true);
+		}
+
+		void appendNull()
+		{
+			offsets_.push_back(offsets_.back());
+			validity_.append(false);
+		}
+
+		[[nodiscard]] std::size_t size() const noexcept
+		{
+			return offsets_.size() - 1;
+		}
+
+		void exportTo(ArrowArray* array, ArrowSchema* schema, const char* name, bool nullable)
+		{
+			const auto length = size();
+			const auto nullCount = validity_.nullCount();
+			ArrayExport node("+L", 1);
+			validity_.exportTo(node);
+			node.addBuffer(std::move(offsets_));
+			offsets_.assign(1, 0);
+			items_.exportTo(node.childArray(0), node.childSchema(0), "item", false);
+			node.finish(array, schema, name, nullable, length, nullCount);
+		}
+
+	private:
+		std::vector<std::int64_t> offsets_;
+		ColumnOf_t<T> items_;
+		Validity validity_;
+	};
+
+	template <typename T>
+	class ColumnOf<std::vector<T>>
+	{
+	public:
+		using type = ListColumn<T>;
+	};
+
+	/**
+	 * @brief Restricted aliases, stored as the column of the aliased type
+	 */
+	template <typename T>
+	class AliasColumn
+	{
+	public:
+		using value_type = T;
+
+		void reserve(std::size_t count)
+		{
+			values_.reserve(count);
+		}
+
+		void append(const value_type& value)
+		{
+			values_.append(value.getValue());
+		}
+
+		void appendNull()
+		{
+			values_.appendNull();
+		}
+
+		[[nodiscard]] std::size_t size() const noexcept
+		{
+			return values_.size();
+		}
+
+		void exportTo(ArrowArray* array, ArrowSchema* schema, const char* name, bool nullable)
+		{
+			values_.exportTo(array, schema, name, nullable);
+		}
+
+	private:
+		ColumnOf_t<typename T::alias_type> values_;
+	};
+
+	template <typename T>
+	class ColumnOf<T, std::void_t<typename T::alias_type>>
+	{
+	public:
+		using type = AliasColumn<T>;
+	};
+
+	/**
+	 * @brief The column of a member, from the return type of its getter
+	 */
+	template <typename Getter>
+	using MemberColumn_t = ColumnOf_t<std::decay_t<Getter>>;
+} // namespace {{ns_tpl}}
@@ -0,0 +1,63 @@
+{%- set req_attrs = type_info|class.req_attrs %}
+{%- set opt_attrs = type_info|class.opt_attrs %}
+{%- set inherited_attrs = type_info|class.inherited_attrs|dict.values|sum(start=[]) %}
+{%- set all_attrs = inherited_attrs + req_attrs + opt_attrs -%}
+#include "{{type_name}}Builder.h"
+
+namespace {{ns_tpl}}
+{
+	void {{type_name}}Builder::reserve(std::size_t count)
+	{
+		{%- for attr in all_attrs %}
+		{{attr|member.var_name}}.reserve(count);
+		{%- endfor %}
+		validity_.reserve(count);
+	}
+
+	void {{type_name}}Builder::append(const value_type& value)
+	{
+		{%- for attr in all_attrs %}
+		{{attr|member.var_name}}.append(value.{{attr|member.getter}}());
+		{%- endfor %}
+		validity_.append(true);
+		++size_;
+	}
+
+	void {{type_name}}Builder::append(const value_type* values, std::size_t count)
+	{
+		reserve(size_ + count);
+		for(std::size_t i = 0; i < count; ++i)
+		{
+			append(values[i]);
+		}
+	}
+
+	void {{type_name}}Builder::appendNull()
+	{
+		{%- for attr in all_attrs %}
+		{{attr|member.var_name}}.appendNull();
+		{%- endfor %}
+		validity_.append(false);
+		++size_;
+	}
+
+	std::size_t {{type_name}}Builder::size() const noexcept
+	{
+		return size_;
+	}
+
+	void {{type_name}}Builder::exportTo(ArrowArray* array, ArrowSchema* schema, const char* name, bool nullable)
+	{
+		const auto length = size_;
+		const auto nullCount = validity_.nullCount();
+		// appendNull() appends a null to every child, so the children are nullable whenever the struct is
+		const bool childNullable = nullable || nullCount > 0;
+		ArrayExport node("+s", {{all_attrs|length}});
+		validity_.exportTo(node);
+		{%- for attr in all_attrs %}
+		{{attr|member.var_name}}.exportTo(node.childArray({{loop.index0}}), node.childSchema({{loop.index0}}), "{{attr|member.val_name}}", childNullable);
+		{%- endfor %}
+		size_ = 0;
+		node.finish(array, schema, name, nullable, length, nullCount);
+	}
+} // namespace {{ns_tpl}}
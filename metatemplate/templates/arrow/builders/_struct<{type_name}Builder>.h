@@ -0,0 +1,81 @@
+{%- set req_attrs = type_info|class.req_attrs %}
+{%- set opt_attrs = type_info|class.opt_attrs %}
+{%- set inherited_attrs = type_info|class.inherited_attrs|dict.values|sum(start=[]) %}
+{%- set all_attrs = inherited_attrs + req_attrs + opt_attrs -%}
+#pragma once
+
+#include <cstddef>
+#include <utility>
+
+#include "{{path_package}}/builders/Columns.h"
+#include "{{path_api}}/types/{{type_name}}_cpp.h"
+{%- set nested = [] %}
+{%- for attr in all_attrs if attr is not member.is_native and attr is not member.is_abstract and (attr|member.class) is class.is_complex_type %}
+{%- set _ = nested.append((attr|member.class).name) %}
+{%- endfor %}
+{%- for name in nested|sort|unique %}
+#include "{{path_package}}/builders/{{name}}Builder.h"
+{%- endfor %}
+{%- set factories = [] %}
+{%- for attr in all_attrs if attr is member.is_abstract %}
+{%- set _ = factories.append((attr|member.class).name) %}
+{%- endfor %}
+{%- for name in factories|sort|unique %}
+#include "{{path_api}}/types/{{name}}Factory.h"
+{%- endfor %}
+
+namespace {{ns_tpl}}
+{
+	/**
+	 * @brief Arrow struct column of {{type_name}}, one child per field (inherited fields first).
+	 * Exported on its own it is a record batch.
+	 */
+	class {{type_name}}Builder
+	{
+	public:
+		using value_type = {{ns_api}}::types::{{type_name}};
+
+		/**
+		 * @brief Reserves every column for count values in total
+		 */
+		void reserve(std::size_t count);
+
+		void append(const value_type& value);
+
+		/**
+		 * @brief Appends count consecutive values
+		 */
+		void append(const value_type* values, std::size_t count);
+
+		/**
+		 * @brief Appends a null struct, every field column gets a null slot
+		 */
+		void appendNull();
+
+		[[nodiscard]] std::size_t size() const noexcept;
+
+		/**
+		 * @brief Moves all columns to the consumer of array/schema, the builder is empty afterwards
+		 *
+		 * @param array: the exported data, released by the consumer
+		 * @param schema: the exported type, released by the consumer
+		 * @param name: the field name
+		 * @param nullable: if the exported field is nullable
+		 */
+		void exportTo(ArrowArray* array, ArrowSchema* schema, const char* name = "{{type_name}}", bool nullable = false);
+
+	private:
+		{%- for attr in all_attrs %}
+		MemberColumn_t<decltype(std::declval<const value_type&>().{{attr|member.getter}}())> {{attr|member.var_name}};
+		{%- endfor %}
+		Validity validity_;
+		std::size_t size_ = 0;
+	};
+
+	template <>
+	class ColumnOf<{{type_name}}Builder::value_type>
+	{
+	public:
+		using type = {{type_name}}Builder;
+	};
+} // namespace {{ns_tpl}}
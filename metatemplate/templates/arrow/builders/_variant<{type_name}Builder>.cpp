@@ -0,0 +1,55 @@
+{%- set choices = type_info|variant.choices -%}
+#include "{{type_name}}Builder.h"
+
+namespace {{ns_tpl}}
+{
+	void {{type_name}}Builder::reserve(std::size_t count)
+	{
+		typeIds_.reserve(count);
+		offsets_.reserve(count);
+	}
+
+	void {{type_name}}Builder::next(std::int8_t typeId, std::size_t childSize)
+	{
+		typeIds_.push_back(typeId);
+		offsets_.push_back(builders_impl::toOffset<std::int32_t>(childSize));
+	}
+
+	void {{type_name}}Builder::append(const value_type& value)
+	{
+		switch(value.heldChoice())
+		{
+			{%- for choice in choices %}
+			case value_type::Choice::{{choice.name}}:
+				next({{loop.index0}}, {{choice.name|names.val_name}}_.size());
+				{{choice.name|names.val_name}}_.append(value.get{{choice.name}}());
+				break;
+			{%- endfor %}
+		}
+	}
+
+	void {{type_name}}Builder::appendNull()
+	{
+		next(0, {{choices[0].name|names.val_name}}_.size());
+		{{choices[0].name|names.val_name}}_.appendNull();
+	}
+
+	std::size_t {{type_name}}Builder::size() const noexcept
+	{
+		return typeIds_.size();
+	}
+
+	void {{type_name}}Builder::exportTo(ArrowArray* array, ArrowSchema* schema, const char* name, bool nullable)
+	{
+		const auto length = typeIds_.size();
+		ArrayExport node("+ud:{% for choice in choices %}{{loop.index0}}{{"," if not loop.last}}{% endfor %}", {{choices|length}});
+		node.addBuffer(std::move(typeIds_));
+		node.addBuffer(std::move(offsets_));
+		typeIds_.clear();
+		offsets_.clear();
+		{%- for choice in choices %}
+		{{choice.name|names.val_name}}_.exportTo(node.childArray({{loop.index0}}), node.childSchema({{loop.index0}}), "{{choice.name}}", true);
+		{%- endfor %}
+		node.finish(array, schema, name, nullable, length, 0);
+	}
+} // namespace {{ns_tpl}}
@@ -0,0 +1,80 @@
+{%- set choices = type_info|variant.choices -%}
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "{{path_package}}/builders/Columns.h"
+#include "{{path_api}}/types/{{type_name}}_cpp.h"
+{%- set nested = [] %}
+{%- for choice in choices if choice.as_attr is not member.is_native and choice.as_attr is not member.is_abstract and (choice.as_attr|member.class) is class.is_complex_type %}
+{%- set _ = nested.append((choice.as_attr|member.class).name) %}
+{%- endfor %}
+{%- for name in nested|sort|unique %}
+#include "{{path_package}}/builders/{{name}}Builder.h"
+{%- endfor %}
+{%- set factories = [] %}
+{%- for choice in choices if choice.as_attr is member.is_abstract %}
+{%- set _ = factories.append((choice.as_attr|member.class).name) %}
+{%- endfor %}
+{%- for name in factories|sort|unique %}
+#include "{{path_api}}/types/{{name}}Factory.h"
+{%- endfor %}
+
+namespace {{ns_tpl}}
+{
+	/**
+	 * @brief Arrow dense union column of {{type_name}}, one child per choice, the type id
+	 * of a value is the index of its choice.
+	 */
+	class {{type_name}}Builder
+	{
+	public:
+		using value_type = {{ns_api}}::types::{{type_name}};
+
+		/**
+		 * @brief Reserves the type ids and offsets for count values in total
+		 */
+		void reserve(std::size_t count);
+
+		void append(const value_type& value);
+
+		/**
+		 * @brief Unions have no validity, a null is a null of the first choice
+		 */
+		void appendNull();
+
+		[[nodiscard]] std::size_t size() const noexcept;
+
+		/**
+		 * @brief Moves all columns to the consumer of array/schema, the builder is empty afterwards
+		 *
+		 * @param array: the exported data, released by the consumer
+		 * @param schema: the exported type, released by the consumer
+		 * @param name: the field name
+		 * @param nullable: if the exported field is nullable
+		 */
+		void exportTo(ArrowArray* array, ArrowSchema* schema, const char* name = "{{type_name}}", bool nullable = false);
+
+	private:
+		/**
+		 * @brief Records the type id and the offset into the child of the next value
+		 */
+		void next(std::int8_t typeId, std::size_t childSize);
+
+		{%- for choice in choices %}
+		MemberColumn_t<decltype(std::declval<const value_type&>().get{{choice.name}}())> {{choice.name|names.val_name}}_;
+		{%- endfor %}
+		std::vector<std::int8_t> typeIds_;
+		std::vector<std::int32_t> offsets_;
+	};
+
+	template <>
+	class ColumnOf<{{type_name}}Builder::value_type>
+	{
+	public:
+		using type = {{type_name}}Builder;
+	};
+} // namespace {{ns_tpl}}
@@ -0,0 +1,20 @@
+#pragma once
+
+// Precompiled header for the {{ns_package}} library, only the stable
+// std, protobuf and utils headers shared by most of the converters belong here.
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <google/protobuf/any.pb.h>
+#include <google/protobuf/repeated_field.h>
+
+#include "{{path_package}}/conversions/Converter.h"
+#include "{{path_package}}/utils/PopulateMutex.h"
+#include "{{path_package}}/utils/Native.h"
+#include "{{path_package}}/utils/Vector.h"
@@ -0,0 +1,6 @@
+// Unity (jumbo) translation unit, compiles the following sources together so the
+// protobuf and api headers are parsed once per bundle.
+// Only rendered with --unity N, compile these instead of the individual sources.
+{% for source in unity_sources %}
+#include "{{source}}"
+{%- endfor %}
@@ -3,14 +3,14 @@
 
 namespace {{ns_tpl}}
 {
-	bool Convert{{type_name}}::from_protobuf({{ns_package}}::{{type_name}}& dest, const {{ns_package}}::{{type_name}}& src)
+	bool Convert{{type_name}}::from_protobuf({{ns_api}}::types::{{type_name}}& dest, const {{ns_protobuf}}::types::{{type_name}}& src)
 	{
         const auto lock = std::scoped_lock{utils::populateMutex};
 		dest = src.value();
 		return true;
 	}
 
-    bool Convert{{type_name}}::to_protobuf({{ns_package}}::{{type_name}}& dest, const {{ns_package}}::{{type_name}}& src)
+    bool Convert{{type_name}}::to_protobuf({{ns_protobuf}}::types::{{type_name}}& dest, const {{ns_api}}::types::{{type_name}}& src)
     {
         const auto lock = std::scoped_lock{utils::populateMutex};
         dest.set_value(src);
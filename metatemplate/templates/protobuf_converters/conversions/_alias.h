@@ -1,7 +1,8 @@
 #pragma once
 
 #include "Converter.h"
-#include "{{path_package}}/{{type_name}}.pb.h"
+#include "{{type_name}}.pb.h"
+#include "{{path_api}}/types/{{type_name}}.h"
 
 {%- if type_name is member.has_include_override %}
 {%- for file in type_name | member.include_override %}
@@ -14,17 +15,17 @@ namespace {{ns_tpl}}
     class Convert{{type_name}}
     {
     public:
-        static bool to_protobuf({{ns_package}}::{{type_name}}& dest, const {{ns_package}}::{{type_name}}& src);
-        static bool from_protobuf({{ns_package}}::{{type_name}}& dest, const {{ns_package}}::{{type_name}}& src);
+        static bool to_protobuf({{ns_protobuf}}::types::{{type_name}}& dest, const {{ns_api}}::types::{{type_name}}& src);
+        static bool from_protobuf({{ns_api}}::types::{{type_name}}& dest, const {{ns_protobuf}}::types::{{type_name}}& src);
     };
 
     template<>
-    class Converter<{{ns_package}}::{{type_name}}, {{ns_package}}::{{type_name}}>
+    class Converter<{{ns_api}}::types::{{type_name}}, {{ns_protobuf}}::types::{{type_name}}>
     {
     public:
         using type = Convert{{type_name}};
-        using protobuf_ns = {{ns_package}}::{{type_name}};
-        using cpp_ns = {{ns_package}}::{{type_name}};
+        using protobuf_ns = {{ns_protobuf}}::types::{{type_name}};
+        using cpp_ns = {{ns_api}}::types::{{type_name}};
     };
 
 } // namespace {{ns_tpl}}
\ No newline at end of file
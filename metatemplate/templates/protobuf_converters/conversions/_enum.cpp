@@ -3,16 +3,16 @@
 
 namespace {{ns_tpl}}
 {
-    bool Convert{{type_name}}::from_protobuf({{ns_package}}::{{type_name}}& dest, const {{ns_package}}::{{type_name}}& src)
+    bool Convert{{type_name}}::from_protobuf({{ns_api}}::types::{{type_name}}& dest, const {{ns_protobuf}}::types::{{type_name}}& src)
     {
         const auto lock = std::scoped_lock{utils::populateMutex};
         switch (src)
         {
             
             {%- for attr in type_info.attrs %}
-            case {{ns_package}}::{{type_name}}::{{type_name}}_{{attr|enum.name}}:
+            case {{ns_protobuf}}::types::{{type_name}}_{{attr|enum.name}}:
             {
-                dest = {{ns_package}}::{{type_name}}::{{attr|enum.name}};
+                dest = {{ns_api}}::types::{{type_name}}::{{attr|enum.name}};
 				break;
 			} 
             {%- endfor %}
@@ -25,15 +25,15 @@ namespace {{ns_tpl}}
 		return true;
 	}
 
-    bool Convert{{type_name}}::to_protobuf({{ns_package}}::{{type_name}}& dest, const {{ns_package}}::{{type_name}}& src)
+    bool Convert{{type_name}}::to_protobuf({{ns_protobuf}}::types::{{type_name}}& dest, const {{ns_api}}::types::{{type_name}}& src)
     {
         const auto lock = std::scoped_lock{utils::populateMutex};
         switch (src)
         {
             {%- for attr in type_info.attrs %}
-            case {{ns_package}}::{{type_name}}::{{attr|enum.name}}:
+            case {{ns_api}}::types::{{type_name}}::{{attr|enum.name}}:
             {
-                dest = {{ns_package}}::{{type_name}}::{{type_name}}_{{attr|enum.name}};
+                dest = {{ns_protobuf}}::types::{{type_name}}_{{attr|enum.name}};
 				break;
 			} 
             {%- endfor %}
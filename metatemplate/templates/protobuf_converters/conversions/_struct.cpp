@@ -10,6 +10,10 @@
 #include "{{path_package}}/utils/Vector.h"
 {%- endif %}
 
+{%- if type_info.attrs|select('member.is_abstract')|list %}
+#include "{{path_package}}/utils/SharedPtr.h"
+{%- endif %}
+
 // include dependencies
 {%- set included_files = [] %}
 {%- for attr in type_info.attrs|select('member.is_custom')|list %}
@@ -49,61 +53,95 @@
 namespace {{ns_tpl}}
 {
     {%- if type_info.attrs or type_info.extensions %}
-    bool Convert{{type_name}}::from_protobuf({{ns_package}}::{{type_name}}& dest, const {{ns_package}}::{{type_name}}& src)
+    bool Convert{{type_name}}::from_protobuf({{ns_api}}::types::{{type_name}}& dest, const {{ns_protobuf}}::types::{{type_name}}& src)
     {
         bool success = true;
 
         const auto lock = std::scoped_lock{utils::populateMutex};
 
+        {%- for ex in type_info.extensions %}
+        success &= Converter<{{ns_api}}::types::{{ex|ext.type}}, {{ns_protobuf}}::types::{{ex|ext.type}}>::type::from_protobuf(dest, src.parent());
+        {%- endfor %}
+
         {%- for attr in type_info.attrs %}
-        {%- set protobuf_getter = attr.name.lower().replace("_", "") %}
-        {%- set protobuf_setter = "set_" + attr.name.lower().replace("_", "") %}
-    
-        {%- set cpp_getter = "get" + attr.name | member.set_first_uppercase %}
-        {%- set cpp_setter = "set" + attr.name | member.set_first_uppercase %}
-        
+        {%- set field = (attr|member.val_name).lower() %}
+        {%- set getter = attr|member.getter %}
+        {%- set setter = attr|member.setter %}
         {
-            {%- if attr is member.is_native and attr is not member.is_list %}
-            dest.{{cpp_setter}}(src.{{protobuf_getter}}());
-
-            {%- elif attr is member.is_list and attr is member.is_primitive_list %}
-            {%- if "{http://www.w3.org/2001/XMLSchema}double" in attr.types[0].qname %}
-            std::vector<double> temp_vector;
+            {%- if attr is member.is_list and attr is member.is_native %}
+            dest.{{setter}}(std::decay_t<decltype(dest.{{getter}}())>(src.{{field}}().begin(), src.{{field}}().end()));
+
+            {%- elif attr is member.is_list and attr is member.is_enum %}
+            std::decay_t<decltype(dest.{{getter}}())> values;
+            values.reserve(static_cast<std::size_t>(src.{{field}}().size()));
+            for (const auto value : src.{{field}}())
+            {
+                {{ns_api}}::types::{{attr|member.base_type_name}} converted{};
+                success &= Converter<{{ns_api}}::types::{{attr|member.base_type_name}}, {{ns_protobuf}}::types::{{attr|member.base_type_name}}>::type::from_protobuf(
+                    converted, static_cast<{{ns_protobuf}}::types::{{attr|member.base_type_name}}>(value));
+                values.push_back(converted);
+            }
+            dest.{{setter}}(std::move(values));
+
+            {%- elif attr is member.is_list %}
+            std::decay_t<decltype(dest.{{getter}}())> values;
+            using ConversionType = Converter<decltype(values), std::decay_t<decltype(src.{{field}}())>>::type;
+            success &= ConversionType::from_protobuf(values, src.{{field}}());
+            dest.{{setter}}(std::move(values));
+
+            {%- elif attr is member.is_native and attr is member.is_optional_type %}
+            if (src.has_{{field}}())
+            {
+                dest.{{setter}}(src.{{field}}());
+            }
+            else
+            {
+                dest.{{setter}}Opt(std::nullopt);
+            }
 
-            const auto& {{protobuf_getter}} = src.{{protobuf_getter}}();
-            std::copy({{protobuf_getter}}.begin(), {{protobuf_getter}}.end(), std::back_inserter(temp_vector));
+            {%- elif attr is member.is_native %}
+            dest.{{setter}}(src.{{field}}());
 
-            {%- else %}
-            std::vector<{{ns_package}}::{{attr.types[0].qname}}> temp_vector;
-
-            for (int i = 0; i < src.{{protobuf_getter}}().size(); ++i) {
-                temp_vector.push_back(src.{{protobuf_getter}}(i));
+            {%- elif attr is member.is_enum %}
+            {%- if attr is member.is_optional_type %}
+            if (!src.has_{{field}}())
+            {
+                dest.{{setter}}Opt(std::nullopt);
             }
-
+            else
             {%- endif %}
-            using ConversionType = Converter<
-                std::decay_t<decltype(dest.{{cpp_getter}}())>,
-                std::decay_t<decltype(temp_vector)>
-            >::type;
-
-            auto temp_dest = dest.{{cpp_getter}}();
-
-            success &= ConversionType::from_protobuf(temp_dest, temp_vector);
+            {
+                {{ns_api}}::types::{{attr|member.base_type_name}} value{};
+                success &= Converter<{{ns_api}}::types::{{attr|member.base_type_name}}, {{ns_protobuf}}::types::{{attr|member.base_type_name}}>::type::from_protobuf(value, src.{{field}}());
+                dest.{{setter}}(value);
+            }
 
-            dest.{{cpp_setter}}(temp_dest);
+            {%- elif attr is member.is_abstract or attr is member.is_optional_type %}
+            if (!src.has_{{field}}())
+            {
+                {%- if attr is member.is_abstract %}
+                dest.{{setter}}(nullptr);
+                {%- else %}
+                dest.{{setter}}Opt(std::nullopt);
+                {%- endif %}
+            }
+            else
+            {
+                {%- if attr is member.is_abstract %}
+                std::decay_t<decltype(dest.{{getter}}())> value;
+                {%- else %}
+                typename std::decay_t<decltype(dest.{{getter}}())>::value_type value;
+                {%- endif %}
+                using ConversionType = Converter<decltype(value), std::decay_t<decltype(src.{{field}}())>>::type;
+                success &= ConversionType::from_protobuf(value, src.{{field}}());
+                dest.{{setter}}(std::move(value));
+            }
 
             {%- else %}
-            using ConversionType = Converter<
-                std::decay_t<decltype(dest.{{cpp_getter}}())>, 
-                std::decay_t<decltype(src.{{protobuf_getter}}())>
-            >::type;
-            
-            auto temp_dest = dest.{{cpp_getter}}();
-            auto temp_src = src.{{protobuf_getter}}();
-
-            success &= ConversionType::from_protobuf(temp_dest, temp_src);
-
-            dest.{{cpp_setter}}(temp_dest);
+            std::decay_t<decltype(dest.{{getter}}())> value;
+            using ConversionType = Converter<decltype(value), std::decay_t<decltype(src.{{field}}())>>::type;
+            success &= ConversionType::from_protobuf(value, src.{{field}}());
+            dest.{{setter}}(std::move(value));
             {%- endif %}
         }
         {%- endfor %}
@@ -111,71 +149,91 @@ namespace {{ns_tpl}}
         return success;
     }
     {%- else %}
-    bool Convert{{type_name}}::from_protobuf({{ns_package}}::{{type_name}}& /*dest*/, const {{ns_package}}::{{type_name}}& /*src*/)
+    bool Convert{{type_name}}::from_protobuf({{ns_api}}::types::{{type_name}}& /*dest*/, const {{ns_protobuf}}::types::{{type_name}}& /*src*/)
     {
         return true;
     }
     {%- endif %}
 
     {%- if type_info.attrs or type_info.extensions %}
-    bool Convert{{type_name}}::to_protobuf({{ns_package}}::{{type_name}}& dest, const {{ns_package}}::{{type_name}}& src)
+    bool Convert{{type_name}}::to_protobuf({{ns_protobuf}}::types::{{type_name}}& dest, const {{ns_api}}::types::{{type_name}}& src)
     {
         bool success = true;
 
         const auto lock = std::scoped_lock{utils::populateMutex};
 
+        {%- for ex in type_info.extensions %}
+        success &= Converter<{{ns_api}}::types::{{ex|ext.type}}, {{ns_protobuf}}::types::{{ex|ext.type}}>::type::to_protobuf(*dest.mutable_parent(), src);
+        {%- endfor %}
+
         {%- for attr in type_info.attrs %}
-        {%- set protobuf_getter = attr.name.lower().replace("_", "") %}
-        {%- set protobuf_setter = "set_" + attr.name.lower().replace("_", "") %}
-        {%- set protobuf_mutable = "mutable_" + attr.name.lower().replace("_", "") %}
-        {%- set protobuf_adder = "add_" + attr.name.lower().replace("_", "") %}
-        {%- set cpp_getter = "get" + attr.name | member.set_first_uppercase %}
-        {%- set cpp_setter = "set" + attr.name | member.set_first_uppercase %}
+        {%- set field = (attr|member.val_name).lower() %}
+        {%- set getter = attr|member.getter %}
         {
+            {%- if attr is member.is_list and attr is member.is_native %}
+            auto& values = *dest.mutable_{{field}}();
+            values.Clear();
+            values.Reserve(static_cast<int>(src.{{getter}}().size()));
+            for (const auto& value : src.{{getter}}())
+            {
+                *values.Add() = value;
+            }
 
-            {%- if attr is member.is_native and attr is not member.is_list %}
-            dest.{{protobuf_setter}}(src.{{cpp_getter}}());
+            {%- elif attr is member.is_list and attr is member.is_enum %}
+            dest.clear_{{field}}();
+            for (const auto value : src.{{getter}}())
+            {
+                {{ns_protobuf}}::types::{{attr|member.base_type_name}} converted{};
+                success &= Converter<{{ns_api}}::types::{{attr|member.base_type_name}}, {{ns_protobuf}}::types::{{attr|member.base_type_name}}>::type::to_protobuf(converted, value);
+                dest.add_{{field}}(converted);
+            }
 
-            {%- elif attr is member.is_simple and attr is not member.is_list %}
-            dest.{{protobuf_setter}}(src.{{cpp_getter}}.getValue());
+            {%- elif attr is member.is_list %}
+            using ConversionType = Converter<std::decay_t<decltype(src.{{getter}}())>, std::decay_t<decltype(*dest.mutable_{{field}}())>>::type;
+            success &= ConversionType::to_protobuf(*dest.mutable_{{field}}(), src.{{getter}}());
 
-            {%- elif attr is member.is_list and attr is member.is_primitive_list %}
-            {%- if "{http://www.w3.org/2001/XMLSchema}double" in attr.types[0].qname %}
-            std::vector<double> temp_vector;
-            {%- else %}
-            std::vector<{{path_package}}::{{attr.types[0].qname}}> temp_vector;
-            {%- endif %}
+            {%- elif attr is member.is_native and attr is member.is_optional_type %}
+            if (const auto& value = src.{{getter}}())
+            {
+                dest.set_{{field}}(*value);
+            }
+            else
+            {
+                dest.clear_{{field}}();
+            }
 
-            using ConversionType = Converter<
-                std::decay_t<decltype(src.{{cpp_getter}}())>,
-                std::decay_t<decltype(temp_vector)>
-            >::type;
+            {%- elif attr is member.is_native %}
+            dest.set_{{field}}(src.{{getter}}());
 
-            auto temp_src = src.{{cpp_getter}}();
+            {%- elif attr is member.is_enum %}
+            {%- if attr is member.is_optional_type %}
+            if (!src.{{getter}}())
+            {
+                dest.clear_{{field}}();
+            }
+            else
+            {%- endif %}
+            {
+                {{ns_protobuf}}::types::{{attr|member.base_type_name}} value{};
+                success &= Converter<{{ns_api}}::types::{{attr|member.base_type_name}}, {{ns_protobuf}}::types::{{attr|member.base_type_name}}>::type::to_protobuf(
+                    value, {{"*" if attr is member.is_optional_type}}src.{{getter}}());
+                dest.set_{{field}}(value);
+            }
 
-            success &= ConversionType::to_protobuf(temp_vector, temp_src);
+            {%- elif attr is member.is_abstract or attr is member.is_optional_type %}
+            if (const auto& value = src.{{getter}}())
+            {
+                using ConversionType = Converter<std::decay_t<decltype({{"value" if attr is member.is_abstract else "*value"}})>, std::decay_t<decltype(*dest.mutable_{{field}}())>>::type;
+                success &= ConversionType::to_protobuf(*dest.mutable_{{field}}(), {{"value" if attr is member.is_abstract else "*value"}});
+            }
+            else
+            {
+                dest.clear_{{field}}();
+            }
 
-            std::for_each(temp_vector.begin(), temp_vector.end(), [&dest] (const auto& element){
-                dest.add_{{attr.name.lower().replace("_", "")}}(element);
-            });
-            {%- else %}
-            using ConversionType = Converter<
-                std::decay_t<decltype(src.{{cpp_getter}}())>,
-                std::decay_t<decltype(dest.{{protobuf_getter}}())> 
-            >::type;
-            {%- if attr is member.is_enum %}
-            auto temp_dest = dest.{{protobuf_getter}}();
-            auto temp_src = src.{{cpp_getter}}();
-
-            success &= ConversionType::to_protobuf(temp_dest, temp_src);
-            
-            dest.{{protobuf_setter}}(temp_dest);
             {%- else %}
-            auto temp_dest = dest.{{protobuf_mutable}}();
-            const auto &temp_src = src.{{cpp_getter}}();
-
-            success &= ConversionType::to_protobuf(*temp_dest, temp_src);
-            {%- endif %}
+            using ConversionType = Converter<std::decay_t<decltype(src.{{getter}}())>, std::decay_t<decltype(*dest.mutable_{{field}}())>>::type;
+            success &= ConversionType::to_protobuf(*dest.mutable_{{field}}(), src.{{getter}}());
             {%- endif %}
         }
         {%- endfor %}
@@ -183,7 +241,7 @@ namespace {{ns_tpl}}
         return success;
     }
     {%- else %}
-    bool Convert{{type_name}}::to_protobuf({{ns_package}}::{{type_name}}& /*dest*/, const {{ns_package}}::{{type_name}}& /*src*/)
+    bool Convert{{type_name}}::to_protobuf({{ns_protobuf}}::types::{{type_name}}& /*dest*/, const {{ns_api}}::types::{{type_name}}& /*src*/)
     {
         return true;
     }
@@ -13,6 +13,10 @@
 #include "{{path_package}}/utils/Vector.h"
 {%- endif %}
 
+{%- if type_info|variant.choices|map(attribute='as_attr')|select('member.is_abstract')|list %}
+#include "{{path_package}}/utils/SharedPtr.h"
+{%- endif %}
+
 {%- for attr in type_info|variant.choices|map(attribute='as_attr')|select('member.is_custom')|list %}
 #include {{attr|util.include(path_package)}}
 {%- endfor %}
@@ -27,63 +31,91 @@
 
 namespace {{ns_tpl}}
 {
-    bool Convert{{type_name}}::from_protobuf({{ns_package}}::{{type_name}}& dest, const {{ns_package}}::{{type_name}}& src)
+    bool Convert{{type_name}}::from_protobuf({{ns_api}}::types::{{type_name}}& dest, const {{ns_protobuf}}::types::{{type_name}}& src)
     {
         bool success = true;
         const auto lock = std::scoped_lock{utils::populateMutex};
         switch (src.choice())
         {
             {%- for choice in type_info|variant.choices %}
-            case {{ns_package}}::{{type_name}}ChoiceType::{{type_name}}Choice_{{choice.name}}: 
+            {%- set field = choice.name.lower() %}
+            case {{ns_protobuf}}::types::{{type_name}}Choice_{{choice.name}}:
             {
-                {%-if choice.as_attr is member.is_native and choice.as_attr is not member.is_list %}
-                dest.set{{choice.name}}(src.{{choice.name}}());
-				break;
+                {%- if choice.as_attr is member.is_list and choice.as_attr is member.is_native %}
+                dest.set{{choice.name}}(std::decay_t<decltype(dest.get{{choice.name}}())>(src.{{field}}().begin(), src.{{field}}().end()));
+                {%- elif choice.as_attr is member.is_list and choice.as_attr is member.is_enum %}
+                std::decay_t<decltype(dest.get{{choice.name}}())> values;
+                for (const auto value : src.{{field}}())
+                {
+                    {{ns_api}}::types::{{choice.as_attr|member.base_type_name}} converted{};
+                    success &= Converter<{{ns_api}}::types::{{choice.as_attr|member.base_type_name}}, {{ns_protobuf}}::types::{{choice.as_attr|member.base_type_name}}>::type::from_protobuf(
+                        converted, static_cast<{{ns_protobuf}}::types::{{choice.as_attr|member.base_type_name}}>(value));
+                    values.push_back(converted);
+                }
+                dest.set{{choice.name}}(std::move(values));
+                {%- elif choice.as_attr is member.is_native %}
+                dest.set{{choice.name}}(src.{{field}}());
                 {%- else %}
-                auto temp_{{choice.raw_type}} = {{ns_package}}::{{choice.raw_type}}();
-				using ConversionType =  Converter<
-                    std::remove_reference_t<decltype(temp_{{choice.raw_type}})>,
-                    std::remove_cv_t<std::remove_reference_t<decltype(src.{{choice.name.lower()}}())>>
-                >::type;
-                
-                success &= ConversionType::from_protobuf(temp_{{choice.raw_type}}, src.{{choice.name.lower()}}());
-                dest = temp_{{choice.raw_type}};
+                std::decay_t<decltype(dest.get{{choice.name}}())> value{};
+                using ConversionType = Converter<decltype(value), std::decay_t<decltype(src.{{field}}())>>::type;
+                success &= ConversionType::from_protobuf(value, src.{{field}}());
+                dest.set{{choice.name}}(std::move(value));
+                {%- endif %}
                 break;
-				{%- endif %}
-			}
+            }
             {%- endfor %}
             default:
             {
-				return false;
-			}
+                return false;
+            }
         }
 
-		return true;
-	}
+        return success;
+    }
 
-    bool Convert{{type_name}}::to_protobuf({{ns_package}}::{{type_name}}& dest, const {{ns_package}}::{{type_name}}& src)
+    bool Convert{{type_name}}::to_protobuf({{ns_protobuf}}::types::{{type_name}}& dest, const {{ns_api}}::types::{{type_name}}& src)
     {
+        bool success = true;
         const auto lock = std::scoped_lock{utils::populateMutex};
-   
-        {%- for choice in type_info|variant.choices %}
-        if (std::holds_alternative<{{ns_package}}::{{choice.raw_type}}>(src))
+        dest.Clear();
+        switch (src.heldChoice())
         {
-            dest.set_choice({{ns_package}}::{{type_name}}ChoiceType::{{type_name}}Choice_{{choice.name}});
-            {%- if choice.as_attr is member.is_native and choice.as_attr is not member.is_list %}
-            dest.{{choice.name}}(src);
-            break;
-            {%- else %}
-            auto temp_src = std::get<{{ns_package}}::{{choice.raw_type}}>(src);
-            using ConversionType = Converter<
-                std::remove_reference_t<decltype(temp_src)>,
-                std::remove_cv_t<std::remove_reference_t<decltype(dest.{{choice.raw_type.lower()}}())>>
-            >::type;
-            
-            auto temp_dest = dest.mutable_{{choice.raw_type.lower()}}();
-            return ConversionType::to_protobuf(*temp_dest, temp_src);
-            {%- endif %}
+            {%- for choice in type_info|variant.choices %}
+            {%- set field = choice.name.lower() %}
+            case {{ns_api}}::types::{{type_name}}::Choice::{{choice.name}}:
+            {
+                dest.set_choice({{ns_protobuf}}::types::{{type_name}}Choice_{{choice.name}});
+                {%- if choice.as_attr is member.is_list and choice.as_attr is member.is_native %}
+                for (const auto& value : src.get{{choice.name}}())
+                {
+                    *dest.mutable_{{field}}()->Add() = value;
+                }
+                {%- elif choice.as_attr is member.is_list and choice.as_attr is member.is_enum %}
+                for (const auto value : src.get{{choice.name}}())
+                {
+                    {{ns_protobuf}}::types::{{choice.as_attr|member.base_type_name}} converted{};
+                    success &= Converter<{{ns_api}}::types::{{choice.as_attr|member.base_type_name}}, {{ns_protobuf}}::types::{{choice.as_attr|member.base_type_name}}>::type::to_protobuf(converted, value);
+                    dest.add_{{field}}(converted);
+                }
+                {%- elif choice.as_attr is member.is_native %}
+                dest.set_{{field}}(src.get{{choice.name}}());
+                {%- elif choice.as_attr is member.is_enum %}
+                {{ns_protobuf}}::types::{{choice.as_attr|member.base_type_name}} value{};
+                success &= Converter<{{ns_api}}::types::{{choice.as_attr|member.base_type_name}}, {{ns_protobuf}}::types::{{choice.as_attr|member.base_type_name}}>::type::to_protobuf(value, src.get{{choice.name}}());
+                dest.set_{{field}}(value);
+                {%- else %}
+                using ConversionType = Converter<std::decay_t<decltype(src.get{{choice.name}}())>, std::decay_t<decltype(*dest.mutable_{{field}}())>>::type;
+                success &= ConversionType::to_protobuf(*dest.mutable_{{field}}(), src.get{{choice.name}}());
+                {%- endif %}
+                break;
+            }
+            {%- endfor %}
+            default:
+            {
+                return false;
+            }
         }
-        {%- endfor %}        
-		return true;
-	}
+
+        return success;
+    }
 } // namespace {{ns_tpl}}
\ No newline at end of file
@@ -1,7 +1,7 @@
 #pragma once
 
+#include "Duration.pb.h"
 #include "{{path_package}}/conversions/Converter.h"
-#include "{{path_package}}/types/Duration.pb.h"
 #include <chrono>
 
 namespace {{ns_package}}::conversions
@@ -9,15 +9,16 @@ namespace {{ns_package}}::conversions
     class ConvertDuration
     {
     public:
-        static bool to_protobuf({{ns_package}}::types::Duration& dest, const std::chrono::nanoseconds& src);
-        static bool from_protobuf(std::chrono::nanoseconds& dest, const {{ns_package}}::types::Duration& src);
+        static bool to_protobuf({{ns_protobuf}}::types::Duration& dest, const std::chrono::nanoseconds& src);
+        static bool from_protobuf(std::chrono::nanoseconds& dest, const {{ns_protobuf}}::types::Duration& src);
     };
 
     template<>
-    class Converter<std::chrono::nanoseconds, {{ns_package}}::types::Duration>
+    class Converter<std::chrono::nanoseconds, {{ns_protobuf}}::types::Duration>
     {
     public:
         using type = ConvertDuration;
-        using protobuf_ns = {{ns_package}}::types::Duration;
+        using protobuf_ns = {{ns_protobuf}}::types::Duration;
+        using cpp_ns = std::chrono::nanoseconds;
     };
-} // namespace {{ns_package}}::conversions
\ No newline at end of file
+} // namespace {{ns_package}}::conversions
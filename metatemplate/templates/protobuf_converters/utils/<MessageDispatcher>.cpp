@@ -0,0 +1,80 @@
+#include "MessageDispatcher.h"
+
+namespace {{ns_package}}
+{
+    void MessageDispatcher::off({{ns_protobuf}}::types::TypeMapEnum type)
+    {
+        const auto index = static_cast<std::size_t>(type);
+        if (index < slots_.size())
+        {
+            slots_[index].route = nullptr;
+        }
+    }
+
+    MessageDispatcher::Result MessageDispatcher::dispatch(const {{ns_protobuf}}::types::MessageWrapper& wrapper)
+    {
+        // an open proto3 enum can hold any int, anything past the table is from a newer schema
+        const auto index = static_cast<std::size_t>(wrapper.type());
+        if (index >= slots_.size())
+        {
+            unknown_.fetch_add(1, std::memory_order_relaxed);
+            return Result::UNKNOWN_TYPE;
+        }
+
+        auto& slot = slots_[index];
+        if (!slot.route)
+        {
+            slot.noHandler.fetch_add(1, std::memory_order_relaxed);
+            return Result::NO_HANDLER;
+        }
+
+        const auto result = slot.route(wrapper.message());
+        switch (result)
+        {
+            case Result::HANDLED:
+                slot.handled.fetch_add(1, std::memory_order_relaxed);
+                break;
+            case Result::UNPACK_FAILED:
+                slot.unpackFailed.fetch_add(1, std::memory_order_relaxed);
+                break;
+            case Result::CONVERSION_FAILED:
+                slot.conversionFailed.fetch_add(1, std::memory_order_relaxed);
+                break;
+            default:
+                break;
+        }
+        return result;
+    }
+
+    MessageDispatcher::Counts MessageDispatcher::counts({{ns_protobuf}}::types::TypeMapEnum type) const
+    {
+        Counts counts;
+        const auto index = static_cast<std::size_t>(type);
+        if (index < slots_.size())
+        {
+            const auto& slot = slots_[index];
+            counts.handled = slot.handled.load(std::memory_order_relaxed);
+            counts.noHandler = slot.noHandler.load(std::memory_order_relaxed);
+            counts.unpackFailed = slot.unpackFailed.load(std::memory_order_relaxed);
+            counts.conversionFailed = slot.conversionFailed.load(std::memory_order_relaxed);
+        }
+        return counts;
+    }
+
+    std::uint64_t MessageDispatcher::unknownCount() const
+    {
+        return unknown_.load(std::memory_order_relaxed);
+    }
+
+    void MessageDispatcher::resetCounts()
+    {
+        for (auto& slot : slots_)
+        {
+            slot.handled.store(0, std::memory_order_relaxed);
+            slot.noHandler.store(0, std::memory_order_relaxed);
+            slot.unpackFailed.store(0, std::memory_order_relaxed);
+            slot.conversionFailed.store(0, std::memory_order_relaxed);
+        }
+        unknown_.store(0, std::memory_order_relaxed);
+    }
+} // namespace {{ns_package}}
@@ -0,0 +1,140 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+#include <google/protobuf/any.pb.h>
+#include <google/protobuf/message.h>
+
+#include "MessageWrapper.pb.h"
+#include "{{path_package}}/conversions/Converter.h"
+#include "{{path_package}}/utils/TypeMappings.h"
+
+namespace {{ns_package}}
+{
+    /**
+     * @brief Routes a MessageWrapper (type + google.protobuf.Any) to a typed handler in O(1),
+     * the TypeMapEnum value indexes a dense table with one slot per type. A slot unpacks the
+     * Any into the RecieveMap ProtoType, converts it to the CppType and calls the handler.
+     *
+     * Register every handler before dispatching, on() is not thread safe. dispatch() may be
+     * called from several threads (handlers then have to be too), the counters are relaxed atomics.
+     */
+    class MessageDispatcher
+    {
+    public:
+        enum class Result
+        {
+            HANDLED,
+            UNKNOWN_TYPE,
+            NO_HANDLER,
+            UNPACK_FAILED,
+            CONVERSION_FAILED
+        };
+
+        /**
+         * @brief Snapshot of the counters of one type
+         */
+        struct Counts
+        {
+            std::uint64_t handled{0};
+            std::uint64_t noHandler{0};
+            std::uint64_t unpackFailed{0};
+            std::uint64_t conversionFailed{0};
+        };
+
+        /// the TypeMapEnum values are dense, 0 to TYPE_COUNT - 1
+        static constexpr std::size_t TYPE_COUNT = {{class_map|length}};
+
+        /**
+         * @brief Registers (or replaces) the handler for a type
+         *
+         * @tparam T: the wrapper type to handle
+         * @param handler: called with the converted CppType&
+         */
+        template<{{ns_protobuf}}::types::TypeMapEnum T, typename Handler>
+        void on(Handler handler)
+        {
+            using CppType = typename RecieveMap<T>::CppType;
+            using ProtoType = typename RecieveMap<T>::ProtoType;
+            static_assert(std::is_base_of_v<google::protobuf::Message, ProtoType>,
+                          "only messages can be packed in a google.protobuf.Any");
+            static_assert(std::is_default_constructible_v<CppType>,
+                          "abstract types are dispatched through their concrete types");
+            static_assert(std::is_invocable_v<const Handler&, CppType&>,
+                          "the handler has to take the CppType of the RecieveMap");
+
+            slots_[static_cast<std::size_t>(T)].route = [handler = std::move(handler)](const google::protobuf::Any& message)
+            {
+                ProtoType proto;
+                if (!message.UnpackTo(&proto))
+                {
+                    return Result::UNPACK_FAILED;
+                }
+                CppType value;
+                if (!conversions::Converter<CppType, ProtoType>::type::from_protobuf(value, proto))
+                {
+                    return Result::CONVERSION_FAILED;
+                }
+                handler(value);
+                return Result::HANDLED;
+            };
+        }
+
+        /**
+         * @brief Registers (or replaces) the handler for a type, looked up with the SendMap
+         *
+         * @tparam CppType: the generated type to handle
+         * @param handler: called with the converted CppType&
+         */
+        template<typename CppType, typename Handler>
+        void on(Handler handler)
+        {
+            on<SendMap<CppType>::enumType>(std::move(handler));
+        }
+
+        /**
+         * @brief Removes the handler of a type, its messages then count as noHandler
+         */
+        void off({{ns_protobuf}}::types::TypeMapEnum type);
+
+        /**
+         * @brief Unpacks, converts and hands the wrapped message to the handler of its type
+         *
+         * @param wrapper: the received wrapper
+         * @returns HANDLED or why the message was dropped
+         */
+        Result dispatch(const {{ns_protobuf}}::types::MessageWrapper& wrapper);
+
+        /**
+         * @brief Counters of a type since construction or the last resetCounts()
+         */
+        Counts counts({{ns_protobuf}}::types::TypeMapEnum type) const;
+
+        /**
+         * @brief Number of wrappers with a type outside of the TypeMapEnum (newer sender)
+         */
+        std::uint64_t unknownCount() const;
+
+        void resetCounts();
+
+    private:
+        class Slot
+        {
+        public:
+            std::function<Result(const google::protobuf::Any&)> route;
+            std::atomic<std::uint64_t> handled{0};
+            std::atomic<std::uint64_t> noHandler{0};
+            std::atomic<std::uint64_t> unpackFailed{0};
+            std::atomic<std::uint64_t> conversionFailed{0};
+        };
+
+        std::array<Slot, TYPE_COUNT> slots_{};
+        std::atomic<std::uint64_t> unknown_{0};
+    };
+} // namespace {{ns_package}}
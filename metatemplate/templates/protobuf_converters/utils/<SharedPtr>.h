@@ -0,0 +1,48 @@
+#pragma once
+
+#include <memory>
+#include <typeinfo>
+#include "{{path_package}}/utils/PopulateMutex.h"
+#include "{{path_package}}/conversions/Converter.h"
+
+namespace {{ns_package}}::conversions
+{
+    /**
+     * @brief Abstract members are a std::shared_ptr of their base type, their message is the
+     * base message. Only objects of exactly the base type fit, a derived object fails
+     * to_protobuf instead of being sliced.
+     */
+    template<typename CppType, typename ProtoType>
+    class ConvertSharedPtr
+    {
+    public:
+        static bool to_protobuf(ProtoType& dest, const std::shared_ptr<CppType>& src)
+        {
+            if (!src)
+            {
+                dest.Clear();
+                return true;
+            }
+            if (typeid(*src) != typeid(CppType))
+            {
+                return false;
+            }
+            return Converter<CppType, ProtoType>::type::to_protobuf(dest, *src);
+        }
+
+        static bool from_protobuf(std::shared_ptr<CppType>& dest, const ProtoType& src)
+        {
+            auto value = std::make_shared<CppType>();
+            const bool success = Converter<CppType, ProtoType>::type::from_protobuf(*value, src);
+            dest = std::move(value);
+            return success;
+        }
+    };
+
+    template<typename CppType, typename ProtoType>
+    class Converter<std::shared_ptr<CppType>, ProtoType>
+    {
+    public:
+        using type = ConvertSharedPtr<CppType, ProtoType>;
+    };
+} // namespace {{ns_package}}::conversions
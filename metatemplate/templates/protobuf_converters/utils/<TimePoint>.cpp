@@ -0,0 +1,17 @@
+#include "TimePoint.h"
+
+namespace {{ns_package}}::conversions
+{
+    // nanoseconds since the epoch, the same count the byte stream writes
+    bool ConvertTimePoint::from_protobuf({{ns_utils if ns_utils else ns_api}}::utils::TimePoint& dest, const {{ns_protobuf}}::types::TimePoint& src)
+    {
+		dest = {{ns_utils if ns_utils else ns_api}}::utils::TimePoint{ {{ns_utils if ns_utils else ns_api}}::utils::Duration{src.value()} };
+		return true;
+	}
+
+    bool ConvertTimePoint::to_protobuf({{ns_protobuf}}::types::TimePoint& dest, const {{ns_utils if ns_utils else ns_api}}::utils::TimePoint& src)
+    {
+		dest.set_value(src.time_since_epoch().count());
+		return true;
+	}
+} // namespace {{ns_package}}::conversions
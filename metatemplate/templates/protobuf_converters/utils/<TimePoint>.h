@@ -0,0 +1,24 @@
+#pragma once
+
+#include "TimePoint.pb.h"
+#include "{{path_package}}/conversions/Converter.h"
+#include "{{path_utils if ns_utils else path_api}}/utils/Clock.h"
+
+namespace {{ns_package}}::conversions
+{
+    class ConvertTimePoint
+    {
+    public:
+        static bool to_protobuf({{ns_protobuf}}::types::TimePoint& dest, const {{ns_utils if ns_utils else ns_api}}::utils::TimePoint& src);
+        static bool from_protobuf({{ns_utils if ns_utils else ns_api}}::utils::TimePoint& dest, const {{ns_protobuf}}::types::TimePoint& src);
+    };
+
+    template<>
+    class Converter<{{ns_utils if ns_utils else ns_api}}::utils::TimePoint, {{ns_protobuf}}::types::TimePoint>
+    {
+    public:
+        using type = ConvertTimePoint;
+        using protobuf_ns = {{ns_protobuf}}::types::TimePoint;
+        using cpp_ns = {{ns_utils if ns_utils else ns_api}}::utils::TimePoint;
+    };
+} // namespace {{ns_package}}::conversions
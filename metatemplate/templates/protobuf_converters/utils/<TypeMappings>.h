@@ -1,39 +1,46 @@
 #pragma once
 
 #include <string_view>
-#include "protobuf_ns/types/TypeMapEnum.pb.h"
+#include "TypeMapEnum.pb.h"
 
-namespace protobuf_ns::types
-{
-{%- set complex_types = [] %}
+// enums can't be forward declared without their underlying type, include them instead
 {%- for type_name, _type in class_map|dictsort %}
-class {{type_name}};
+{%- if _type.is_enumeration %}
+#include "{{type_name}}.pb.h"
+#include "{{path_api}}/types/{{type_name}}.h"
+{%- endif %}
 {%- endfor %}
-} // namespace protobuf_ns::types
-
-
-namespace cpp_ns::types {
-    {%- for class_name in classes %}
-    {%- if class_name in complex_types %}
-    class {{ class_name }};
-    {%- endif %}
-    {%- endfor %}
-} // namespace cpp_ns
 
+namespace {{ns_protobuf}}::types
+{
+{%- for type_name, _type in class_map|dictsort %}
+{%- if not _type.is_enumeration %}
+    class {{type_name}};
+{%- endif %}
+{%- endfor %}
+} // namespace {{ns_protobuf}}::types
 
+namespace {{ns_api}}::types
+{
+{%- for type_name, _type in class_map|dictsort %}
+{%- if not _type.is_enumeration %}
+    class {{type_name}};
+{%- endif %}
+{%- endfor %}
+} // namespace {{ns_api}}::types
 
 namespace {{ns_package}}
 {
-    template<protobuf_ns::TypeMapEnum T>
+    template<{{ns_protobuf}}::types::TypeMapEnum T>
     class RecieveMap;
 
 {%- for type_name, _type in class_map|dictsort %}
     template<>
-    class RecieveMap<::TypeMapEnum::TypeMapEnum_{{type_name}}>
+    class RecieveMap<{{ns_protobuf}}::types::TypeMapEnum_{{type_name}}>
     {
     public:
-        using CppType = cpp_ns::types::{{type_name}};
-        using ProtoType = protobuf_ns::types::{{type_name}};
+        using CppType = {{ns_api}}::types::{{type_name}};
+        using ProtoType = {{ns_protobuf}}::types::{{type_name}};
     };
 {% endfor %}
 
@@ -43,10 +50,10 @@ namespace {{ns_package}}
 {%- for type_name, _type in class_map|dictsort %}
 
     template<>
-    class SendMap<cpp_ns::types::{{type_name}}>
+    class SendMap<{{ns_api}}::types::{{type_name}}>
     {
     public:
-        const ::types::TypeMapEnum enumType = ::types::TypeMapEnum_{{type_name}};
+        static constexpr {{ns_protobuf}}::types::TypeMapEnum enumType = {{ns_protobuf}}::types::TypeMapEnum_{{type_name}};
     };
 {% endfor %}
-} // namespace {{ns_package}}
\ No newline at end of file
+} // namespace {{ns_package}}
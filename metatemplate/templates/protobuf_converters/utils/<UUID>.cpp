@@ -1,24 +1,26 @@
-#include "{{path_package}}/utils/PopulateMutex.h"
 #include "UUID.h"
-#include <string>
-#include <array>
+#include <cstring>
 
 namespace {{ns_package}}::conversions
 {
-    bool ConvertUuid::from_protobuf(std::array<std::uint8_t, 16>& dest, const c::types::UUID& src)
+    // the leaf converters only touch dest/src so they don't take utils::populateMutex,
+    // the 16 bytes are copied straight in/out of the protobuf string
+
+    bool ConvertUuid::from_protobuf({{ns_utils if ns_utils else ns_api}}::utils::UUID& dest, const {{ns_protobuf}}::types::UUID& src)
     {
-        const auto lock = std::scoped_lock{utils::populateMutex};
-        auto tempStr = src.value();
-        std::copy_n(tempStr.begin(), std::min(tempStr.size(), dest.size()), dest.begin());
+        const auto& value = src.value();
+        if (value.size() != sizeof(dest.data))
+        {
+            return false;
+        }
+        std::memcpy(dest.data, value.data(), sizeof(dest.data));
 		return true;
 	}
 
-    bool ConvertUuid::to_protobuf(::types::UUID& dest, const std::array<std::uint8_t, 16>& src)
+    bool ConvertUuid::to_protobuf({{ns_protobuf}}::types::UUID& dest, const {{ns_utils if ns_utils else ns_api}}::utils::UUID& src)
     {
-        const auto lock = std::scoped_lock{utils::populateMutex};
-        std::string tempStr{};
-        std::transform(src.begin(), src.end(), std::back_inserter(tempStr), [](const auto ch) {return static_cast<char>(ch);});
-        dest.set_value(std::move(tempStr));
+        // assigns into the existing string, no allocation once a reused message has one
+        dest.set_value(reinterpret_cast<const char*>(src.data), sizeof(src.data));
 		return true;
 	}
-} // namespace {{ns_package}}::conversions
\ No newline at end of file
+} // namespace {{ns_package}}::conversions
@@ -1,23 +1,24 @@
 #pragma once
 
-#include "/types/UUID.pb.h"
+#include "UUID.pb.h"
 #include "{{path_package}}/conversions/Converter.h"
+#include "{{path_utils if ns_utils else path_api}}/utils/UUID.h"
 
 namespace {{ns_package}}::conversions
 {
     class ConvertUuid
     {
-    public:    
-        static bool from_protobuf(std::array<std::uint8_t, 16>& dest, const types::UUID& src);
-        static bool to_protobuf(::types::UUID& dest, const std::array<std::uint8_t, 16>& src);
+    public:
+        static bool from_protobuf({{ns_utils if ns_utils else ns_api}}::utils::UUID& dest, const {{ns_protobuf}}::types::UUID& src);
+        static bool to_protobuf({{ns_protobuf}}::types::UUID& dest, const {{ns_utils if ns_utils else ns_api}}::utils::UUID& src);
     };
 
     template<>
-    class Converter<std::array<std::uint8_t, 16>, :types::UUID>
+    class Converter<{{ns_utils if ns_utils else ns_api}}::utils::UUID, {{ns_protobuf}}::types::UUID>
     {
     public:
         using type = ConvertUuid;
-        using protobuf_ns = c::types::UUID;
-        using cpp_ns = std::array<std::uint8_t, 16>;
+        using protobuf_ns = {{ns_protobuf}}::types::UUID;
+        using cpp_ns = {{ns_utils if ns_utils else ns_api}}::utils::UUID;
     };
-} // namespace {{ns_package}}::conversions
\ No newline at end of file
+} // namespace {{ns_package}}::conversions
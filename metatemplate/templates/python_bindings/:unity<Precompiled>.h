@@ -0,0 +1,12 @@
+#pragma once
+
+// Precompiled header for the {{ns_package}} python module.
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
@@ -3,6 +3,7 @@ This file defines the Python module for all of the {{ns_api}} C++ classes.
 */
 
 #include <pybind11/pybind11.h>
+#include "bindings/BatchBindings.h"
 
 namespace py = pybind11;
 
@@ -22,12 +23,6 @@ PYBIND11_MODULE(python, m)
     m.doc() = "Python bindings for {{ns_api}} types";
 
     {% if not ns_utils %}
-    // std::byte for serialization
-    py::class_<std::byte>(m, "StdByte", py::module_local())
-        //Lambda function constructor to convert int to std::byte
-        .def(py::init([](int arg) {
-        return std::unique_ptr<std::byte>(new std::byte ( (std::byte)arg ));
-        }));
     bindClock(m);
     bindUUID(m);
     {% endif %}
@@ -35,4 +30,7 @@ PYBIND11_MODULE(python, m)
     {% for type_name, _type in class_map|dictsort -%}
     bind{{type_name}}(m);
     {% endfor %}
+    // batches mixing any of the struct types above, dispatched on the class ID of each message
+    m.def("decode_many", &batch_bindings::decodeAny, py::arg("buffer"), py::arg("offsets"), py::arg("threads") = 0);
+    m.def("encode_many", &batch_bindings::encodeAny, py::arg("values"), py::arg("threads") = 0);
 }
\ No newline at end of file
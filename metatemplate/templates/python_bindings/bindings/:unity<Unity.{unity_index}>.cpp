@@ -0,0 +1,6 @@
+// Unity (jumbo) translation unit, pybind11 headers are by far the most expensive
+// part of every binding source, bundling parses them once per batch.
+// Only rendered with --unity N, compile these instead of the individual sources.
+{% for source in unity_sources %}
+#include "{{source}}"
+{%- endfor %}
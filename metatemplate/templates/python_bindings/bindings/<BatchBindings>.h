@@ -0,0 +1,342 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+#include <{{path_utils if ns_utils else path_api}}/byte_stream/Batch.h>
+
+// Many message encode/decode for the python module. Messages are passed as one buffer
+// plus offsets[count + 1], message i is buffer[offsets[i], offsets[i + 1]). The GIL is
+// released while encoding/decoding and large batches are split over threads.
+namespace batch_bindings
+{
+    namespace py = pybind11;
+    namespace bs = {{ns_utils if ns_utils else ns_api}}::byte_stream;
+
+    using Offsets = py::array_t<std::uint64_t, py::array::c_style | py::array::forcecast>;
+
+    /**
+     * @brief A contiguous python buffer split into messages, keeps the buffer alive
+     */
+    class Records
+    {
+    public:
+        /**
+         * @brief Checks the buffer is contiguous and the offsets are in bounds
+         *
+         * @throws py::value_error on a strided buffer or bad offsets
+         */
+        Records(const py::buffer& buffer, const Offsets& offsets) : info_(buffer.request())
+        {
+            if (info_.ndim > 1 || (info_.ndim == 1 && info_.strides[0] != info_.itemsize))
+            {
+                throw py::value_error("decode_many expects a contiguous buffer");
+            }
+            if (offsets.ndim() != 1 || offsets.size() < 1)
+            {
+                throw py::value_error("decode_many expects 1 dimensional offsets of count + 1 entries");
+            }
+            offsets_.assign(offsets.data(), offsets.data() + offsets.size());
+            for (std::size_t i = 1; i < offsets_.size(); ++i)
+            {
+                if (offsets_[i] < offsets_[i - 1])
+                {
+                    throw py::value_error("decode_many offsets must not decrease, offset " + std::to_string(i));
+                }
+            }
+            const auto size = static_cast<std::uint64_t>(info_.size * info_.itemsize);
+            if (offsets_.back() > size)
+            {
+                throw py::value_error("decode_many offsets exceed the buffer size " + std::to_string(size));
+            }
+        }
+
+        [[nodiscard]] std::size_t count() const
+        {
+            return offsets_.size() - 1;
+        }
+
+        [[nodiscard]] const std::byte* data(std::size_t i) const
+        {
+            return static_cast<const std::byte*>(info_.ptr) + offsets_[i];
+        }
+
+        [[nodiscard]] std::size_t size(std::size_t i) const
+        {
+            return static_cast<std::size_t>(offsets_[i + 1] - offsets_[i]);
+        }
+
+    private:
+        py::buffer_info info_;
+        std::vector<std::uint64_t> offsets_;
+    };
+
+    /**
+     * @brief Decodes record i into value, the record has to be exactly one valid T
+     *
+     * @throws py::value_error naming the record if it is truncated, corrupt or has trailing bytes
+     */
+    template <typename T>
+    void decodeRecord(const Records& records, std::size_t i, T& value)
+    {
+        try
+        {
+            bs::IByteStream stream(records.data(i), records.size(i));
+            stream >> value;
+            if (stream.ok() && stream.end())
+            {
+                return;
+            }
+        }
+        catch (const std::runtime_error& error)
+        {
+            // a class ID that doesn't match
+            throw py::value_error("decode_many record " + std::to_string(i) + ": " + error.what());
+        }
+        throw py::value_error("decode_many record " + std::to_string(i) + " is truncated or corrupt");
+    }
+
+    /**
+     * @brief Decodes every record as a T with the GIL released
+     *
+     * @param threads: 0 uses all cores, 1 stays on the calling thread
+     */
+    template <typename T>
+    [[nodiscard]] std::vector<T> decode(const Records& records, std::size_t threads)
+    {
+        std::vector<T> values(records.count());
+        py::gil_scoped_release release;
+        bs::batch_impl::parallelFor(values.size(), bs::batch_impl::threadCount(values.size(), threads),
+            [&](std::size_t, std::size_t begin, std::size_t end) {
+                for (std::size_t i = begin; i < end; ++i)
+                {
+                    decodeRecord(records, i, values[i]);
+                }
+            });
+        return values;
+    }
+
+    /**
+     * @brief Moves the values into a list of bound objects
+     */
+    template <typename T>
+    [[nodiscard]] py::list toList(std::vector<T>&& values)
+    {
+        py::list list(values.size());
+        for (std::size_t i = 0; i < values.size(); ++i)
+        {
+            list[i] = py::cast(std::move(values[i]));
+        }
+        return list;
+    }
+
+    /**
+     * @brief Encodes count messages with encodeOne(i, stream), the GIL released
+     *
+     * @return py::tuple (bytes, offsets) accepted by decode_many
+     */
+    template <typename Encode>
+    [[nodiscard]] py::tuple encode(std::size_t count, std::size_t threads, Encode&& encodeOne)
+    {
+        const std::size_t chunks = bs::batch_impl::threadCount(count, threads);
+        std::vector<bs::OByteStream> parts(chunks);
+        std::vector<std::size_t> chunkBegin(chunks + 1, count);
+        std::vector<std::uint64_t> offsets(count + 1);
+        {
+            py::gil_scoped_release release;
+            bs::batch_impl::parallelFor(count, chunks, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+                chunkBegin[chunk] = begin;
+                for (std::size_t i = begin; i < end; ++i)
+                {
+                    offsets[i] = parts[chunk].size();
+                    encodeOne(i, parts[chunk]);
+                }
+            });
+        }
+
+        // chunk offsets are relative to their part, shift them by the preceding parts
+        std::size_t total = 0;
+        for (std::size_t chunk = 0; chunk < chunks; ++chunk)
+        {
+            for (std::size_t i = chunkBegin[chunk]; i < chunkBegin[chunk + 1]; ++i)
+            {
+                offsets[i] += total;
+            }
+            total += parts[chunk].size();
+        }
+        offsets[count] = total;
+
+        auto bytes = py::reinterpret_steal<py::bytes>(PyBytes_FromStringAndSize(nullptr, static_cast<Py_ssize_t>(total)));
+        if (!bytes)
+        {
+            throw py::error_already_set();
+        }
+        char* out = PyBytes_AS_STRING(bytes.ptr());
+        for (const auto& part : parts)
+        {
+            std::memcpy(out, part.buffer().data(), part.size());
+            out += part.size();
+        }
+        return py::make_tuple(std::move(bytes), Offsets(offsets.size(), offsets.data()));
+    }
+
+    /**
+     * @brief Encodes a sequence of bound T objects
+     *
+     * @throws py::cast_error if an item is not a T
+     */
+    template <typename T>
+    [[nodiscard]] py::tuple encodeMany(const py::sequence& values, std::size_t threads)
+    {
+        std::vector<const T*> items;
+        items.reserve(values.size());
+        for (const auto item : values)
+        {
+            items.push_back(&item.cast<const T&>());
+        }
+        return encode(items.size(), threads, [&](std::size_t i, bs::OByteStream& stream) { stream << *items[i]; });
+    }
+
+    /**
+     * @brief Type erased encode/decode of one bound message type, for batches of mixed types
+     */
+    struct Codec
+    {
+        std::shared_ptr<void> (*decode)(const Records&, std::size_t);
+        py::object (*toPython)(std::shared_ptr<void>&&);
+        const void* (*pointer)(py::handle);
+        void (*encode)(const void*, bs::OByteStream&);
+    };
+
+    template <typename T>
+    [[nodiscard]] Codec codecOf()
+    {
+        return Codec{
+            [](const Records& records, std::size_t i) -> std::shared_ptr<void> {
+                auto value = std::make_shared<T>();
+                decodeRecord(records, i, *value);
+                return value;
+            },
+            [](std::shared_ptr<void>&& value) { return py::cast(std::move(*static_cast<T*>(value.get()))); },
+            [](py::handle value) -> const void* { return &value.cast<const T&>(); },
+            [](const void* value, bs::OByteStream& stream) { stream << *static_cast<const T*>(value); },
+        };
+    }
+
+    /**
+     * @brief All bound struct types by class ID and python type. Only structs register,
+     * variants and aliases are encoded without a class ID so a mixed batch can't tell them apart.
+     */
+    class Registry
+    {
+    public:
+        [[nodiscard]] static Registry& instance()
+        {
+            static Registry registry;
+            return registry;
+        }
+
+        template <typename T>
+        void add(const py::class_<T>& cls)
+        {
+            byId_.emplace(T::ID(), codecOf<T>());
+            byType_.emplace(cls.ptr(), codecOf<T>());
+        }
+
+        /**
+         * @throws py::value_error if no bound type has the class ID
+         */
+        [[nodiscard]] const Codec& byId(std::uint32_t id) const
+        {
+            const auto found = byId_.find(id);
+            if (found == byId_.end())
+            {
+                throw py::value_error("no bound type has the class ID " + std::to_string(id));
+            }
+            return found->second;
+        }
+
+        /**
+         * @throws py::type_error if the value is not of a bound message type
+         */
+        [[nodiscard]] const Codec& byType(py::handle value) const
+        {
+            const auto found = byType_.find(reinterpret_cast<PyObject*>(Py_TYPE(value.ptr())));
+            if (found == byType_.end())
+            {
+                throw py::type_error("encode_many got a " + std::string(Py_TYPE(value.ptr())->tp_name)
+                    + ", expected a bound struct type");
+            }
+            return found->second;
+        }
+
+    private:
+        std::unordered_map<std::uint32_t, Codec> byId_;
+        std::unordered_map<PyObject*, Codec> byType_;
+    };
+
+    /**
+     * @brief Decodes messages of any bound struct type, each dispatched on its leading class ID
+     */
+    [[nodiscard]] inline py::list decodeAny(const py::buffer& buffer, const Offsets& offsets, std::size_t threads)
+    {
+        const Records records(buffer, offsets);
+        const auto& registry = Registry::instance();
+        std::vector<const Codec*> codecs(records.count());
+        for (std::size_t i = 0; i < codecs.size(); ++i)
+        {
+            if (records.size(i) < sizeof(std::uint32_t))
+            {
+                throw py::value_error("decode_many message " + std::to_string(i) + " is too small for a class ID");
+            }
+            std::uint32_t id;
+            bs::bytestream_impl::readLittleEndian(&id, records.data(i), 1);
+            codecs[i] = &registry.byId(id);
+        }
+
+        std::vector<std::shared_ptr<void>> values(codecs.size());
+        {
+            py::gil_scoped_release release;
+            bs::batch_impl::parallelFor(values.size(), bs::batch_impl::threadCount(values.size(), threads),
+                [&](std::size_t, std::size_t begin, std::size_t end) {
+                    for (std::size_t i = begin; i < end; ++i)
+                    {
+                        values[i] = codecs[i]->decode(records, i);
+                    }
+                });
+        }
+
+        py::list list(values.size());
+        for (std::size_t i = 0; i < values.size(); ++i)
+        {
+            list[i] = codecs[i]->toPython(std::move(values[i]));
+        }
+        return list;
+    }
+
+    /**
+     * @brief Encodes a sequence of objects of any bound struct types
+     */
+    [[nodiscard]] inline py::tuple encodeAny(const py::sequence& values, std::size_t threads)
+    {
+        const auto& registry = Registry::instance();
+        std::vector<std::pair<const Codec*, const void*>> items;
+        items.reserve(values.size());
+        for (const auto item : values)
+        {
+            const auto& codec = registry.byType(item);
+            items.emplace_back(&codec, codec.pointer(item));
+        }
+        return encode(items.size(), threads,
+            [&](std::size_t i, bs::OByteStream& stream) { items[i].first->encode(items[i].second, stream); });
+    }
+} // namespace batch_bindings
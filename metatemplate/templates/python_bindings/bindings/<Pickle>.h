@@ -0,0 +1,85 @@
+#pragma once
+
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include <pybind11/pybind11.h>
+#include <{{path_utils if ns_utils else path_api}}/byte_stream/BufferPool.h>
+#include <{{path_utils if ns_utils else path_api}}/byte_stream/ByteStream.h>
+
+// pickle and copy protocol for the bound types, the pickled state is the byte stream
+// encoding so worker processes (multiprocessing, dask, ...) get the binary format.
+namespace pickle_bindings
+{
+    namespace py = pybind11;
+    namespace bs = {{ns_utils if ns_utils else ns_api}}::byte_stream;
+
+    /**
+     * @brief Encodes the value as python bytes through a pooled buffer
+     */
+    template <typename T>
+    [[nodiscard]] py::bytes toState(const T& value)
+    {
+        auto bytes = bs::BufferPool::acquire();
+        bs::OByteStream stream(std::move(*bytes));
+        stream << value;
+        *bytes = stream.release();
+        return py::bytes(reinterpret_cast<const char*>(bytes->data()), bytes->size());
+    }
+
+    /**
+     * @brief Decodes a value pickled by toState
+     *
+     * @throws py::value_error if the state is truncated, corrupt or has trailing bytes
+     */
+    template <typename T>
+    [[nodiscard]] T fromState(const py::bytes& state)
+    {
+        T value;
+        try
+        {
+            bs::IByteStream stream(static_cast<std::string_view>(state));
+            stream >> value;
+            if (stream.ok() && stream.end())
+            {
+                return value;
+            }
+        }
+        catch (const std::runtime_error& error)
+        {
+            // a class ID that doesn't match
+            throw py::value_error(std::string("unpickling: ") + error.what());
+        }
+        throw py::value_error("unpickling: the pickled state is truncated or corrupt");
+    }
+
+    /**
+     * @brief Adds __getstate__/__setstate__ over the byte stream and __copy__/__deepcopy__
+     * over the C++ copy constructor.
+     *
+     * @tparam SHARED_MEMBERS: abstract members are std::shared_ptr which a copy shares,
+     * types holding them deep copy through the byte stream instead
+     */
+    template <bool SHARED_MEMBERS = false, typename T, typename... Options>
+    void addPickle(py::class_<T, Options...>& cls)
+    {
+        cls.def(py::pickle(
+                [](const T& value) { return toState(value); },
+                [](const py::bytes& state) { return fromState<T>(state); }))
+            .def("__copy__", [](const T& value) { return T(value); })
+            .def("__deepcopy__",
+                [](const T& value, const py::dict&) {
+                    if constexpr (SHARED_MEMBERS)
+                    {
+                        return fromState<T>(toState(value));
+                    }
+                    else
+                    {
+                        return T(value);
+                    }
+                },
+                py::arg("memo"));
+    }
+} // namespace pickle_bindings
@@ -1,4 +1,3 @@
-#include <iostream>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 #include <{{path_api}}/utils/UUID.h>
@@ -9,14 +8,15 @@ using namespace {{ns_api}}::utils;
 void bindUUID(py::module_& m){
     py::class_<UUID>(m, "UUID", py::module_local())
         .def("__str__", [](UUID& id) {
-                return boost::lexical_cast<std::string>(id); })
+                return UUIDtoStr(id); })
         .def("__repr__", [](UUID& id) {
-                return boost::lexical_cast<std::string>(id); })
+                return UUIDtoStr(id); })
 		.def_static(
-			"fromStr", [](const std::string& str) { return boost::lexical_cast<UUID>(str); }, py::arg("id"))
+			"fromStr", [](const std::string& str) { return UUIDfromStr(str); }, py::arg("id"))
 		.def_static("generate", &GenerateUUID)
 		.def("__eq__", [](const UUID& self, const UUID& other) {return self == other;})
-		.def("__ne__", [](const UUID& self, const UUID& other) {return self != other;});
+		.def("__ne__", [](const UUID& self, const UUID& other) {return self != other;})
+		.def("__hash__", [](const UUID& self) {return UUIDHash{}(self);});
 
 		m.def("UUIDToStr", &UUIDtoStr, py::arg("id"));
         m.def("UUIDFromStr", &UUIDfromStr, py::arg("id"));
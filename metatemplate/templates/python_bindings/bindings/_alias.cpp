@@ -1,14 +1,17 @@
-#include <iostream>
 #include <sstream>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 #include <{{path_api}}/types/{{type_name}}.h>
+#include "Pickle.h"
 
 namespace py = pybind11;
 using namespace {{ns_api}}::types;
 
+{%- set class_name = type_name|names.val_name %}
+
 void bind{{type_name}}(py::module_& m) {
-    py::class_<{{type_name}}>(m, "{{type_name}}", py::module_local())
+    py::class_<{{type_name}}> {{class_name}}(m, "{{type_name}}", py::module_local());
+    {{class_name}}
         .def(py::init<>())
         .def(py::init<{{type_name}}::alias_type>())
         .def("getValue", &{{type_name}}::getValue)
@@ -26,4 +29,6 @@ void bind{{type_name}}(py::module_& m) {
                 return ss.str();
             }
         );
+
+    pickle_bindings::addPickle({{class_name}});
 }
@@ -1,4 +1,3 @@
-#include <iostream>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 #include <{{path_api}}/types/{{type_name}}.h>
@@ -12,6 +11,9 @@ void bind{{type_name}}(py::module_& m)
         {%- for attr in type_info.attrs %}
         .value("{{attr|enum.name}}", {{type_name}}::{{attr|enum.name}})
         {%- endfor %}
-        .export_values();
+        .export_values()
+        // pybind11 pickles enums by value already, they are immutable so copies are the value
+        .def("__copy__", []({{type_name}} value) { return value; })
+        .def("__deepcopy__", []({{type_name}} value, const py::dict&) { return value; }, py::arg("memo"));
 
 }
@@ -1,23 +1,61 @@
-#include <iostream>
-#include <sstream>
-#include <pybind11/pybind11.h>
-#include <pybind11/stl.h>
-#include <{{path_api}}/types/{{type_name}}_cpp.h>
-
 {%- set req_attrs = type_info|class.req_attrs %}
 {%- set opt_attrs = type_info|class.opt_attrs %}
 {%- set ordered_attrs = req_attrs + opt_attrs %}
-
 {%- set inherited_attrs = type_info|class.inherited_attrs|dict.values|sum(start=[]) %}
-{%- set all_attrs = ordered_attrs + inherited_attrs %}
+{%- set all_attrs = ordered_attrs + inherited_attrs -%}
+{%- set class_name = type_name|names.val_name -%}
+#include <cstring>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+#include <pybind11/stl.h>
+#include <{{path_utils if ns_utils else path_api}}/byte_stream/BufferPool.h>
+#include <{{path_utils if ns_utils else path_api}}/byte_stream/ByteStream.h>
+#include <{{path_utils if ns_utils else path_api}}/json/Json.h>
+#include <{{path_api}}/types/{{type_name}}_cpp.h>
+#include "BatchBindings.h"
+#include "Pickle.h"
 
 namespace py = pybind11;
 using namespace {{ns_api}}; // for utils, all prefixed with utils::
 using namespace {{ns_api}}::types;
 
+namespace
+{
+    // one column per field, numpy arrays for numbers and lists of values otherwise
+    py::dict {{class_name}}Columns(const std::vector<{{type_name}}>& values)
+    {
+        py::dict columns;
+        {%- for attr in all_attrs %}
+        {
+            {%- if attr is member.is_numeric %}
+            py::array_t<{{attr|member.base_type_name}}> column(values.size());
+            auto* data = column.mutable_data();
+            for (std::size_t i = 0; i < values.size(); ++i)
+            {
+                data[i] = values[i].{{attr|member.getter}}();
+            }
+            {%- else %}
+            py::list column(values.size());
+            for (std::size_t i = 0; i < values.size(); ++i)
+            {
+                column[i] = py::cast(values[i].{{attr|member.getter}}(), py::return_value_policy::copy);
+            }
+            {%- endif %}
+            columns["{{attr|member.val_name}}"] = std::move(column);
+        }
+        {%- endfor %}
+        return columns;
+    }
+} // namespace
+
 void bind{{type_name}}(py::module_& m)
 {
-    py::class_<{{type_name}}>(m, "{{type_name}}", py::module_local())
+    py::class_<{{type_name}}> {{class_name}}(m, "{{type_name}}", py::module_local());
+    {{class_name}}
         .def(py::init<>())
         {% if ordered_attrs|length > req_attrs|length -%}
         .def(py::init<{{type_info|class.all_ctor_types}}>())
@@ -26,13 +64,115 @@ void bind{{type_name}}(py::module_& m)
         .def(py::init<{{type_info|class.req_ctor_types}}>())
         {% endif -%}
         {% for attr in all_attrs -%}
+        {%- if attr is member.is_numeric_list -%}
+        {%- set item_type = attr|member.base_type_name -%}
+        // read only numpy array copied out with one memcpy, it owns its data so setting
+        // the field again can't invalidate it. Setting copies any buffer in one go.
+        .def_property("{{attr|member.val_name}}",
+            [](const {{type_name}}& value) {
+                const auto& values = value.{{attr|member.getter}}();
+                py::array_t<{{item_type}}> copy(values.size());
+                if (!values.empty())
+                {
+                    std::memcpy(copy.mutable_data(), values.data(), values.size() * sizeof({{item_type}}));
+                }
+                copy.attr("setflags")(py::arg("write") = false);
+                return copy;
+            },
+            []({{type_name}}& value, const py::array_t<{{item_type}}, py::array::c_style | py::array::forcecast>& buffer) {
+                if (buffer.ndim() > 1)
+                {
+                    throw py::value_error("{{attr|member.val_name}} expects a 1 dimensional buffer");
+                }
+                value.{{attr|member.setter}}(std::vector<{{item_type}}>(buffer.data(), buffer.data() + buffer.size()));
+            }
+        )
+        {%- else -%}
         .def_property("{{attr|member.val_name}}",
             py::overload_cast<>(&{{type_name}}::{{attr|member.getter}},py::const_),
             &{{type_name}}::{{attr|member.setter}}
         )
+        {%- endif %}
         {% endfor -%}
-        .def("serialize", &{{type_name}}::serialize)
-        .def_static("deserialize", &{{type_name}}::deserialize)
+        .def("serialize",
+            [](const {{type_name}}& value) {
+                auto bytes = byte_stream::BufferPool::acquire();
+                {
+                    py::gil_scoped_release release;
+                    value.serializeInto(*bytes);
+                }
+                return py::bytes(reinterpret_cast<const char*>(bytes->data()), bytes->size());
+            }
+        )
+        // zero-copy from any contiguous buffer (bytes, bytearray, memoryview, mmap, ...)
+        .def_static("deserialize",
+            [](const py::buffer& buffer) {
+                const py::buffer_info info = buffer.request();
+                if (info.ndim > 1 || (info.ndim == 1 && info.strides[0] != info.itemsize))
+                {
+                    throw py::value_error("{{type_name}}.deserialize expects a contiguous buffer");
+                }
+                {{type_name}} value;
+                bool complete;
+                try
+                {
+                    py::gil_scoped_release release;
+                    byte_stream::IByteStream stream(static_cast<const std::byte*>(info.ptr), static_cast<std::size_t>(info.size * info.itemsize));
+                    stream >> value;
+                    complete = stream.ok();
+                }
+                catch (const std::runtime_error& error)
+                {
+                    // a class ID that doesn't match, garbage rather than a failure of ours
+                    throw py::value_error("{{type_name}}.deserialize: " + std::string(error.what()));
+                }
+                if (!complete)
+                {
+                    throw py::value_error("{{type_name}}.deserialize got a truncated or corrupt buffer");
+                }
+                return value;
+            },
+            py::arg("buffer")
+        )
+        // message i is buffer[offsets[i], offsets[i + 1]), decoded with the GIL released
+        .def_static("decode_many",
+            [](const py::buffer& buffer, const batch_bindings::Offsets& offsets, std::size_t threads, bool columnar) -> py::object {
+                const batch_bindings::Records records(buffer, offsets);
+                auto values = batch_bindings::decode<{{type_name}}>(records, threads);
+                if (columnar)
+                {
+                    return {{class_name}}Columns(values);
+                }
+                return batch_bindings::toList(std::move(values));
+            },
+            py::arg("buffer"), py::arg("offsets"), py::arg("threads") = 0, py::arg("columnar") = false
+        )
+        // returns (bytes, offsets) for decode_many
+        .def_static("encode_many",
+            [](const py::sequence& values, std::size_t threads) {
+                return batch_bindings::encodeMany<{{type_name}}>(values, threads);
+            },
+            py::arg("values"), py::arg("threads") = 0
+        )
+        .def("to_json",
+            [](const {{type_name}}& value) {
+                // one writer per thread, its buffer is reused across calls
+                thread_local {{ns_utils if ns_utils else ns_api}}::json::JsonWriter writer;
+                writer.reset();
+                writer.write(value);
+                return py::str(writer.view().data(), writer.view().size());
+            }
+        )
+        .def_static("from_json",
+            [](std::string_view text) {
+                {{ns_utils if ns_utils else ns_api}}::json::JsonReader reader(text);
+                {{type_name}} value;
+                reader.read(value);
+                reader.finish();
+                return value;
+            },
+            py::arg("text")
+        )
         .def("__eq__", [](const {{type_name}}& lhs, const {{type_name}}& rhs) {return lhs == rhs;})
         .def("__repr__",
             [](const {{type_name}}& a) {
@@ -41,4 +181,7 @@ void bind{{type_name}}(py::module_& m)
                 return ss.str();
             }
         );
+
+    pickle_bindings::addPickle<{{"true" if type_info is class.shares_members else "false"}}>({{class_name}});
+    batch_bindings::Registry::instance().add({{class_name}});
 }
\ No newline at end of file
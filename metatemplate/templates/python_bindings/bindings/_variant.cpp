@@ -1,8 +1,10 @@
-#include <iostream>
 #include <sstream>
+#include <string_view>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
+#include <{{path_utils if ns_utils else path_api}}/json/Json.h>
 #include <{{path_api}}/types/{{type_name}}.h>
+#include "Pickle.h"
 
 namespace py = pybind11;
 using namespace {{ns_api}}::types;
@@ -23,6 +25,25 @@ void bind{{type_name}}(py::module_& m)
             &{{type_name}}::set{{choice.name}}
         )
         {%- endfor %}
+        .def("to_json",
+            [](const {{type_name}}& value) {
+                // one writer per thread, its buffer is reused across calls
+                thread_local {{ns_utils if ns_utils else ns_api}}::json::JsonWriter writer;
+                writer.reset();
+                writer.write(value);
+                return py::str(writer.view().data(), writer.view().size());
+            }
+        )
+        .def_static("from_json",
+            [](std::string_view text) {
+                {{ns_utils if ns_utils else ns_api}}::json::JsonReader reader(text);
+                {{type_name}} value;
+                reader.read(value);
+                reader.finish();
+                return value;
+            },
+            py::arg("text")
+        )
         .def("__eq__", [](const {{type_name}}& lhs, const {{type_name}}& rhs) {return lhs == rhs;})
         .def("__repr__",
             [](const {{type_name}}& a) {
@@ -32,6 +53,8 @@ void bind{{type_name}}(py::module_& m)
             }
         );
 
+    pickle_bindings::addPickle<{{"true" if type_info is class.shares_members else "false"}}>({{class_name}});
+
     py::enum_<{{type_name}}::Choice>({{class_name}}, "Choice")
         {%- for choice in type_info|variant.choices %}
         .value("{{choice.name}}", {{type_name}}::Choice::{{choice.name}}) {{-";" if loop.last}}